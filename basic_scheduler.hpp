@@ -0,0 +1,44 @@
+#pragma once
+
+#include "scheduler.hpp"
+#include "simulation.hpp"
+#include <memory_resource>
+#include <utility>
+
+// Scheduler whose slice policy is a compile-time parameter. There is no
+// strategy object or virtual call, so the compiler sees the whole slice loop
+// and can fold a FixedQuantum into it:
+//
+//   BasicScheduler<FixedQuantum<4>> scheduler;
+//   scheduler.addProcesses(procs);
+//   scheduler.run();
+//
+// Scheduler remains the runtime-polymorphic front end; RoundRobinStrategy runs
+// the same kernel with a RuntimeQuantum.
+template <SlicePolicy Policy> class BasicScheduler : public SchedulerBase {
+private:
+  Policy policy;
+
+public:
+  explicit BasicScheduler(
+      Policy policy = Policy{},
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+      : SchedulerBase(upstream), policy(std::move(policy)) {}
+
+  void run() {
+    const size_t before = memory.allocationCount();
+    beginRun();
+    readyQueue.reserve(allProcesses.size());
+    auto &sortedIndices = progress.arrivalOrder;
+    sortByArrival(allProcesses.startTime, sortedIndices);
+    const WorkloadView workload{allProcesses.startTime, allProcesses.burstTime,
+                                sortedIndices};
+    currentTime = simulateRoundRobin(workload, allProcesses.remainingTime,
+                                     allProcesses.endTime, readyQueue, policy,
+                                     currentTime);
+    allProcesses.deriveWaitingTimes();
+    lastRunAllocations = memory.allocationCount() - before;
+  }
+
+  const ProcessTable &getProcesses() const { return allProcesses; }
+};
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Lockstep round-robin engine behind the SIMD backends of simulateBatch.
+//
+// Every file that instantiates runLanes is compiled for its own instruction
+// set, so nothing here may be an inline function or a standard library
+// template shared with the rest of the program: the linker could keep the
+// AVX-512 copy for callers on any CPU. runLanes instantiations take a lane
+// type from an unnamed namespace, which gives each one internal linkage.
+
+constexpr size_t laneCapacity = 64; // Processes per workload in a lane
+
+// The batch as raw columns; see WorkloadBatch
+struct BatchView {
+  const unsigned int *startTime;
+  const unsigned int *burstTime;
+  const size_t *row;
+  const size_t *offsets;
+  size_t workloads;
+  unsigned int quantum;
+  int *endTime;
+  int *waitingTime;
+};
+
+// Runs every workload of at most laneCapacity processes. `Lanes` provides
+// vector operations on Lanes::width 32-bit lanes; lane l works on one
+// workload, whose j-th process in arrival order lives at [j * width + l] of
+// the per-process arrays. Each step admits arrivals, jumps idle lanes to their
+// next arrival, and runs one slice in every lane with work, exactly as
+// resumeRoundRobin does for a single workload.
+template <typename Lanes> void runLanes(const BatchView &batch) {
+  using Vec = typename Lanes::Vec;
+  using Mask = typename Lanes::Mask;
+  constexpr unsigned int width = Lanes::width;
+  constexpr unsigned int shift = Lanes::shift; // log2(width)
+  constexpr size_t slots = laneCapacity * width;
+
+  alignas(64) uint32_t start[slots];
+  alignas(64) uint32_t remaining[slots];
+  alignas(64) uint32_t finish[slots];
+  alignas(64) uint32_t queue[slots]; // Ring of arrival ranks per lane
+  alignas(64) uint32_t laneTime[width];
+  alignas(64) uint32_t laneNext[width];
+  alignas(64) uint32_t laneCount[width];
+  alignas(64) uint32_t laneHead[width];
+  alignas(64) uint32_t laneSize[width];
+  size_t laneWorkload[width];
+  size_t nextWorkload = 0;
+
+  // Loads the next workload that fits into `lane`. Returns false once there
+  // are none left, leaving the lane empty.
+  auto fill = [&](unsigned int lane) {
+    laneTime[lane] = 0;
+    laneNext[lane] = 0;
+    laneHead[lane] = 0;
+    laneSize[lane] = 0;
+    laneCount[lane] = 0;
+    while (nextWorkload < batch.workloads) {
+      const size_t w = nextWorkload++;
+      const size_t first = batch.offsets[w];
+      const size_t processes = batch.offsets[w + 1] - first;
+      if (processes > laneCapacity) {
+        continue; // Left to the scalar kernel
+      }
+      for (uint32_t j = 0; j < processes; ++j) {
+        start[j * width + lane] = batch.startTime[first + j];
+        remaining[j * width + lane] = batch.burstTime[first + j];
+      }
+      if (processes > 0) {
+        laneCount[lane] = processes;
+        laneWorkload[lane] = w;
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto writeBack = [&](unsigned int lane) {
+    const size_t first = batch.offsets[laneWorkload[lane]];
+    for (uint32_t j = 0; j < laneCount[lane]; ++j) {
+      const uint32_t end = finish[j * width + lane];
+      const size_t at = batch.row[first + j];
+      batch.endTime[at] = static_cast<int>(end);
+      batch.waitingTime[at] = static_cast<int>(
+          end - batch.startTime[first + j] - batch.burstTime[first + j]);
+    }
+  };
+
+  uint32_t live = 0;
+  for (unsigned int lane = 0; lane < width; ++lane) {
+    if (fill(lane)) {
+      live |= uint32_t{1} << lane;
+    }
+  }
+
+  const Vec lanes = Lanes::laneIds();
+  const Vec zero = Lanes::set1(0);
+  const Vec quantum = Lanes::set1(batch.quantum);
+  const Vec ringMask = Lanes::set1(laneCapacity - 1);
+  Vec time = Lanes::load(laneTime);
+  Vec next = Lanes::load(laneNext);
+  Vec count = Lanes::load(laneCount);
+  Vec head = Lanes::load(laneHead);
+  Vec size = Lanes::load(laneSize);
+
+  // Queues every process that has arrived by `time`, one per lane at a
+  // time. Returns the start time of each lane's next arrival.
+  auto admit = [&]() {
+    for (;;) {
+      const Mask pending = Lanes::lessThan(next, count);
+      const Vec nextStart =
+          Lanes::gather(pending, start, Lanes::slot(next, shift, lanes));
+      const Mask arrived =
+          Lanes::both(pending, Lanes::atMost(nextStart, time));
+      if (Lanes::bits(arrived) == 0) {
+        return nextStart;
+      }
+      const Vec tail = Lanes::ring(Lanes::add(head, size), ringMask);
+      Lanes::scatter(arrived, queue, Lanes::slot(tail, shift, lanes), next);
+      size = Lanes::increment(arrived, size);
+      next = Lanes::increment(arrived, next);
+    }
+  };
+
+  while (live != 0) {
+    const Vec nextStart = admit();
+    const Mask empty = Lanes::equal(size, zero);
+    const Mask idle = Lanes::both(empty, Lanes::lessThan(next, count));
+    time = Lanes::select(idle, nextStart, time);
+
+    const Mask running = Lanes::inverse(empty);
+    if (Lanes::bits(running) != 0) {
+      const Vec idx =
+          Lanes::gather(running, queue, Lanes::slot(head, shift, lanes));
+      const Vec at = Lanes::slot(idx, shift, lanes);
+      // Lanes that are not running gather 0 and so run for 0
+      Vec left = Lanes::gather(running, remaining, at);
+      const Vec slice = Lanes::min(left, quantum);
+      left = Lanes::sub(left, slice);
+      time = Lanes::add(time, slice);
+      head = Lanes::ring(Lanes::increment(running, head), ringMask);
+      size = Lanes::decrement(running, size);
+
+      // Arrivals during the slice go ahead of the preempted process
+      admit();
+      const Mask done = Lanes::equal(left, zero);
+      const Mask preempted = Lanes::both(running, Lanes::inverse(done));
+      const Vec tail = Lanes::ring(Lanes::add(head, size), ringMask);
+      Lanes::scatter(preempted, queue, Lanes::slot(tail, shift, lanes), idx);
+      size = Lanes::increment(preempted, size);
+      Lanes::scatter(running, remaining, at, left);
+      Lanes::scatter(Lanes::both(running, done), finish, at, time);
+    }
+
+    const uint32_t finished =
+        Lanes::bits(Lanes::both(Lanes::equal(size, zero),
+                                Lanes::equal(next, count))) &
+        live;
+    if (finished != 0) {
+      Lanes::store(laneTime, time);
+      Lanes::store(laneNext, next);
+      Lanes::store(laneCount, count);
+      Lanes::store(laneHead, head);
+      Lanes::store(laneSize, size);
+      for (uint32_t left = finished; left != 0; left &= left - 1) {
+        const unsigned int lane = __builtin_ctz(left);
+        writeBack(lane);
+        if (!fill(lane)) {
+          live &= ~(uint32_t{1} << lane);
+        }
+      }
+      time = Lanes::load(laneTime);
+      next = Lanes::load(laneNext);
+      count = Lanes::load(laneCount);
+      head = Lanes::load(laneHead);
+      size = Lanes::load(laneSize);
+    }
+  }
+}
+
+// Entry points of the SIMD backends, each in its own translation unit
+void runLanesAvx2(const BatchView &batch);
+void runLanesAvx512(const BatchView &batch);
@@ -0,0 +1,80 @@
+// Compiled with -mavx2; only called once the CPU is known to support it
+#include "batch_lanes.hpp"
+#include <immintrin.h>
+
+namespace {
+
+// Masks are vectors with every bit of a selected lane set. AVX2 has no
+// scatter, so those go lane by lane.
+struct Avx2Lanes {
+  using Vec = __m256i;
+  using Mask = __m256i;
+  static constexpr unsigned int width = 8;
+  static constexpr unsigned int shift = 3;
+
+  static Vec laneIds() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+  static Vec set1(uint32_t value) {
+    return _mm256_set1_epi32(static_cast<int>(value));
+  }
+  static Vec load(const uint32_t *from) {
+    return _mm256_load_si256(reinterpret_cast<const __m256i *>(from));
+  }
+  static void store(uint32_t *to, Vec value) {
+    _mm256_store_si256(reinterpret_cast<__m256i *>(to), value);
+  }
+
+  static Vec add(Vec a, Vec b) { return _mm256_add_epi32(a, b); }
+  static Vec sub(Vec a, Vec b) { return _mm256_sub_epi32(a, b); }
+  static Vec min(Vec a, Vec b) { return _mm256_min_epu32(a, b); }
+  static Vec ring(Vec position, Vec mask) {
+    return _mm256_and_si256(position, mask);
+  }
+  static Vec slot(Vec rank, unsigned int shift, Vec lanes) {
+    return _mm256_add_epi32(_mm256_slli_epi32(rank, shift), lanes);
+  }
+  // A mask lane is -1, so subtracting it adds one
+  static Vec increment(Mask mask, Vec value) {
+    return _mm256_sub_epi32(value, mask);
+  }
+  static Vec decrement(Mask mask, Vec value) {
+    return _mm256_add_epi32(value, mask);
+  }
+  static Vec select(Mask mask, Vec ifSet, Vec otherwise) {
+    return _mm256_blendv_epi8(otherwise, ifSet, mask);
+  }
+
+  // Counts and ranks stay far below 2^31, so a signed compare is exact
+  static Mask lessThan(Vec a, Vec b) { return _mm256_cmpgt_epi32(b, a); }
+  static Mask atMost(Vec a, Vec b) {
+    return _mm256_cmpeq_epi32(_mm256_max_epu32(a, b), b);
+  }
+  static Mask equal(Vec a, Vec b) { return _mm256_cmpeq_epi32(a, b); }
+  static Mask both(Mask a, Mask b) { return _mm256_and_si256(a, b); }
+  static Mask inverse(Mask a) {
+    return _mm256_xor_si256(a, _mm256_set1_epi32(-1));
+  }
+  static uint32_t bits(Mask mask) {
+    return static_cast<uint32_t>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+  }
+
+  static Vec gather(Mask mask, const uint32_t *base, Vec index) {
+    return _mm256_mask_i32gather_epi32(_mm256_setzero_si256(),
+                                       reinterpret_cast<const int *>(base),
+                                       index, mask, 4);
+  }
+  static void scatter(Mask mask, uint32_t *base, Vec index, Vec value) {
+    alignas(32) uint32_t indices[width];
+    alignas(32) uint32_t values[width];
+    store(indices, index);
+    store(values, value);
+    for (uint32_t left = bits(mask); left != 0; left &= left - 1) {
+      const unsigned int lane = __builtin_ctz(left);
+      base[indices[lane]] = values[lane];
+    }
+  }
+};
+
+} // namespace
+
+void runLanesAvx2(const BatchView &batch) { runLanes<Avx2Lanes>(batch); }
@@ -0,0 +1,66 @@
+// Compiled with -mavx512f; only called once the CPU is known to support it
+#include "batch_lanes.hpp"
+#include <immintrin.h>
+
+namespace {
+
+// Masks are the AVX-512 mask registers, and scatters are native
+struct Avx512Lanes {
+  using Vec = __m512i;
+  using Mask = __mmask16;
+  static constexpr unsigned int width = 16;
+  static constexpr unsigned int shift = 4;
+
+  static Vec laneIds() {
+    return _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+                             15);
+  }
+  static Vec set1(uint32_t value) {
+    return _mm512_set1_epi32(static_cast<int>(value));
+  }
+  static Vec load(const uint32_t *from) { return _mm512_load_si512(from); }
+  static void store(uint32_t *to, Vec value) { _mm512_store_si512(to, value); }
+
+  static Vec add(Vec a, Vec b) { return _mm512_add_epi32(a, b); }
+  static Vec sub(Vec a, Vec b) { return _mm512_sub_epi32(a, b); }
+  // GCC 12 builds the unmasked min and shift from an uninitialized source and
+  // -Wmaybe-uninitialized reports it, so they use the zero-masked forms with
+  // every lane selected: the same instruction with a zeroed source
+  static constexpr Mask all = 0xFFFF;
+
+  static Vec min(Vec a, Vec b) { return _mm512_maskz_min_epu32(all, a, b); }
+  static Vec ring(Vec position, Vec mask) {
+    return _mm512_and_si512(position, mask);
+  }
+  static Vec slot(Vec rank, unsigned int shift, Vec lanes) {
+    return _mm512_add_epi32(_mm512_maskz_slli_epi32(all, rank, shift), lanes);
+  }
+  static Vec increment(Mask mask, Vec value) {
+    return _mm512_mask_add_epi32(value, mask, value, _mm512_set1_epi32(1));
+  }
+  static Vec decrement(Mask mask, Vec value) {
+    return _mm512_mask_sub_epi32(value, mask, value, _mm512_set1_epi32(1));
+  }
+  static Vec select(Mask mask, Vec ifSet, Vec otherwise) {
+    return _mm512_mask_blend_epi32(mask, otherwise, ifSet);
+  }
+
+  static Mask lessThan(Vec a, Vec b) { return _mm512_cmplt_epi32_mask(a, b); }
+  static Mask atMost(Vec a, Vec b) { return _mm512_cmple_epu32_mask(a, b); }
+  static Mask equal(Vec a, Vec b) { return _mm512_cmpeq_epi32_mask(a, b); }
+  static Mask both(Mask a, Mask b) { return a & b; }
+  static Mask inverse(Mask a) { return static_cast<Mask>(~a); }
+  static uint32_t bits(Mask mask) { return mask; }
+
+  static Vec gather(Mask mask, const uint32_t *base, Vec index) {
+    return _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), mask, index,
+                                       base, 4);
+  }
+  static void scatter(Mask mask, uint32_t *base, Vec index, Vec value) {
+    _mm512_mask_i32scatter_epi32(base, mask, index, value, 4);
+  }
+};
+
+} // namespace
+
+void runLanesAvx512(const BatchView &batch) { runLanes<Avx512Lanes>(batch); }
@@ -0,0 +1,152 @@
+#include "batch_simulation.hpp"
+#include "batch_lanes.hpp"
+#include "simulation.hpp"
+#include <algorithm>
+#include <memory_resource>
+#include <stdexcept>
+
+static_assert(laneCapacity == batchLaneCapacity);
+
+// WorkloadBatch
+void WorkloadBatch::add(std::span<const Process> procs) {
+  order.clear();
+  for (size_t i = 0; i < procs.size(); ++i) {
+    if (procs[i].burstTime > 0) {
+      order.push_back(i);
+    }
+  }
+  // Ties keep the order the processes were added in, as in sortByArrival
+  std::sort(order.begin(), order.end(), [&procs](size_t a, size_t b) {
+    return procs[a].startTime != procs[b].startTime
+               ? procs[a].startTime < procs[b].startTime
+               : a < b;
+  });
+  for (const auto i : order) {
+    startTime.push_back(procs[i].startTime);
+    burstTime.push_back(procs[i].burstTime);
+    row.push_back(rows + i);
+  }
+  offsets.push_back(startTime.size());
+  rows += procs.size();
+}
+
+void WorkloadBatch::reserve(size_t workloads, size_t processes) {
+  startTime.reserve(processes);
+  burstTime.reserve(processes);
+  row.reserve(processes);
+  offsets.reserve(workloads + 1);
+}
+
+void WorkloadBatch::clear() {
+  startTime.clear();
+  burstTime.clear();
+  row.clear();
+  offsets.assign(1, 0);
+  rows = 0;
+}
+
+// Backends
+bool batchBackendSupported(BatchBackend backend) {
+  switch (backend) {
+#ifdef SCHEDULER_SIMD_X86
+  case BatchBackend::Avx2:
+    return __builtin_cpu_supports("avx2");
+  case BatchBackend::Avx512:
+    return __builtin_cpu_supports("avx512f");
+#else
+  case BatchBackend::Avx2:
+  case BatchBackend::Avx512:
+    return false;
+#endif
+  default:
+    return true;
+  }
+}
+
+BatchBackend bestBatchBackend() {
+  for (const auto backend : {BatchBackend::Avx512, BatchBackend::Avx2}) {
+    if (batchBackendSupported(backend)) {
+      return backend;
+    }
+  }
+  return BatchBackend::Scalar;
+}
+
+namespace {
+
+// Scratch for the scalar kernel, reused across workloads
+struct ScalarBuffers {
+  std::pmr::vector<size_t> arrivalOrder;
+  std::vector<unsigned int> remainingTime;
+  std::vector<int> endTime;
+  RingBuffer<unsigned int> readyQueue;
+};
+
+// Runs workload `w` through the same kernel as RoundRobinStrategy
+void simulateOne(const WorkloadBatch &batch, size_t w, unsigned int quantum,
+                 BatchResults &results, ScalarBuffers &buffers) {
+  const size_t first = batch.getOffsets()[w];
+  const size_t count = batch.getOffsets()[w + 1] - first;
+  const auto start = batch.getStartTimes().subspan(first, count);
+  const auto burst = batch.getBurstTimes().subspan(first, count);
+  const auto rows = batch.getRows().subspan(first, count);
+
+  sortByArrival(start, buffers.arrivalOrder); // Already sorted: no swaps
+  buffers.remainingTime.assign(burst.begin(), burst.end());
+  buffers.endTime.assign(count, -1);
+  buffers.readyQueue.clear();
+  const WorkloadView view{start, burst, buffers.arrivalOrder};
+  simulateRoundRobin(view, buffers.remainingTime, buffers.endTime,
+                     buffers.readyQueue, quantum);
+
+  for (size_t i = 0; i < count; ++i) {
+    results.endTime[rows[i]] = buffers.endTime[i];
+    results.waitingTime[rows[i]] = buffers.endTime[i] - start[i] - burst[i];
+  }
+}
+
+} // namespace
+
+void simulateBatch(const WorkloadBatch &batch, unsigned int quantum,
+                   BatchResults &results, BatchBackend backend) {
+  if (quantum == 0) {
+    throw std::invalid_argument("Time quantum must be positive.");
+  }
+  if (!batchBackendSupported(backend)) {
+    throw std::invalid_argument("Batch backend not supported on this CPU.");
+  }
+  if (backend == BatchBackend::Auto) {
+    backend = bestBatchBackend();
+  }
+  // Rows of zero-burst processes are never written below
+  results.endTime.assign(batch.processCount(), -1);
+  results.waitingTime.assign(batch.processCount(), 0);
+
+  const auto offsets = batch.getOffsets();
+  const BatchView view{batch.getStartTimes().data(),
+                       batch.getBurstTimes().data(),
+                       batch.getRows().data(),
+                       offsets.data(),
+                       batch.size(),
+                       quantum,
+                       results.endTime.data(),
+                       results.waitingTime.data()};
+  bool lanesRan = false;
+#ifdef SCHEDULER_SIMD_X86
+  if (backend == BatchBackend::Avx512) {
+    runLanesAvx512(view);
+    lanesRan = true;
+  } else if (backend == BatchBackend::Avx2) {
+    runLanesAvx2(view);
+    lanesRan = true;
+  }
+#endif
+
+  // The lanes skip workloads too big for them
+  ScalarBuffers buffers;
+  for (size_t w = 0; w < batch.size(); ++w) {
+    if (!lanesRan || offsets[w + 1] - offsets[w] > laneCapacity) {
+      simulateOne(batch, w, quantum, results, buffers);
+    }
+  }
+}
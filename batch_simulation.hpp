@@ -0,0 +1,65 @@
+#pragma once
+
+#include "scheduler.hpp"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Round robin over many small, independent workloads at once, for scoring
+// millions of them without building a Scheduler for each.
+
+// Workloads stored back to back as columns, each sorted by arrival once when
+// it is added, so a batch can be scored with many quanta without sorting
+// again. Processes with a zero burst are dropped, as by
+// Scheduler::addProcess, but keep their result row.
+class WorkloadBatch {
+private:
+  std::vector<unsigned int> startTime;
+  std::vector<unsigned int> burstTime;
+  std::vector<size_t> row;        // Result row of each stored process
+  std::vector<size_t> offsets{0}; // Workload w is [offsets[w], offsets[w + 1])
+  size_t rows = 0;                // Processes added, zero bursts included
+  std::vector<size_t> order;      // Scratch for add()
+
+public:
+  void add(std::span<const Process> procs);
+  void reserve(size_t workloads, size_t processes);
+  void clear();
+
+  size_t size() const { return offsets.size() - 1; }
+  size_t processCount() const { return rows; }
+  std::span<const unsigned int> getStartTimes() const { return startTime; }
+  std::span<const unsigned int> getBurstTimes() const { return burstTime; }
+  std::span<const size_t> getRows() const { return row; }
+  std::span<const size_t> getOffsets() const { return offsets; }
+};
+
+// Per-process results, one row per process in the order they were added.
+// Processes with a zero burst never run and get endTime -1.
+struct BatchResults {
+  std::vector<int> endTime;
+  std::vector<int> waitingTime;
+};
+
+// How the batch is simulated. The SIMD backends put one workload in each
+// lane (8 with AVX2, 16 with AVX-512) and run a slice in every lane at once,
+// refilling a lane with the next workload as soon as its own finishes.
+// Workloads of more than batchLaneCapacity processes go through the scalar
+// kernel whatever the backend.
+enum class BatchBackend { Auto, Scalar, Avx2, Avx512 };
+
+inline constexpr size_t batchLaneCapacity = 64;
+
+// Whether this CPU and build can run `backend`; Auto and Scalar always can
+bool batchBackendSupported(BatchBackend backend);
+// The backend Auto stands for on this CPU
+BatchBackend bestBatchBackend();
+
+// Runs every workload of `batch` from time 0 with RoundRobinStrategy's
+// policy, giving the same end and waiting times as Scheduler::run on each.
+// `results` is resized to the batch, so one can serve batch after batch.
+// Throws std::invalid_argument for a zero quantum or a backend this CPU does
+// not support.
+void simulateBatch(const WorkloadBatch &batch, unsigned int quantum,
+                   BatchResults &results,
+                   BatchBackend backend = BatchBackend::Auto);
@@ -0,0 +1,55 @@
+#include "../basic_scheduler.hpp"
+#include "workload.hpp"
+#include <benchmark/benchmark.h>
+
+// Same workload through the virtual Scheduler and the compile-time
+// BasicScheduler. Args: process count.
+static std::vector<Process> comparisonWorkload(size_t count) {
+  WorkloadSpec spec;
+  spec.count = count;
+  spec.burst = BurstDistribution::Exponential;
+  spec.meanBurst = 16;
+  spec.meanGap = 5;
+  return makeWorkload(spec);
+}
+
+template <typename SchedulerT>
+static void runScheduler(benchmark::State &state, SchedulerT &scheduler) {
+  const auto procs = comparisonWorkload(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    scheduler.reset();
+    scheduler.addProcesses(procs);
+    state.ResumeTiming();
+
+    scheduler.run();
+  }
+  state.SetItemsProcessed(state.iterations() * procs.size());
+}
+
+static void BM_VirtualScheduler(benchmark::State &state) {
+  Scheduler scheduler(new RoundRobinStrategy(4));
+  runScheduler(state, scheduler);
+}
+BENCHMARK(BM_VirtualScheduler)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_BasicSchedulerRuntimeQuantum(benchmark::State &state) {
+  BasicScheduler<RuntimeQuantum> scheduler(RuntimeQuantum{4});
+  runScheduler(state, scheduler);
+}
+BENCHMARK(BM_BasicSchedulerRuntimeQuantum)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_BasicSchedulerFixedQuantum(benchmark::State &state) {
+  BasicScheduler<FixedQuantum<4>> scheduler;
+  runScheduler(state, scheduler);
+}
+BENCHMARK(BM_BasicSchedulerFixedQuantum)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
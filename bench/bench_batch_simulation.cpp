@@ -0,0 +1,67 @@
+#include "../batch_simulation.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+
+// Scoring many tiny independent workloads (5-50 processes each), quantum 4.
+// Arg: BatchBackend.
+static const std::vector<std::vector<Process>> &tinyWorkloads() {
+  static const auto workloads = [] {
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<size_t> size(5, 50);
+    std::uniform_int_distribution<unsigned int> arrival(0, 300);
+    std::uniform_int_distribution<unsigned int> burst(1, 30);
+    std::vector<std::vector<Process>> all(100000);
+    for (auto &procs : all) {
+      const size_t n = size(rng);
+      for (unsigned int pid = 0; pid < n; ++pid) {
+        procs.emplace_back(pid, arrival(rng), burst(rng));
+      }
+    }
+    return all;
+  }();
+  return workloads;
+}
+
+static void BM_BatchSimulation(benchmark::State &state) {
+  const auto &workloads = tinyWorkloads();
+  WorkloadBatch batch;
+  for (const auto &procs : workloads) {
+    batch.add(procs);
+  }
+  const auto backend = static_cast<BatchBackend>(state.range(0));
+  if (!batchBackendSupported(backend)) {
+    state.SkipWithError("Backend not supported on this CPU");
+    return;
+  }
+  BatchResults results;
+  for (auto _ : state) {
+    simulateBatch(batch, 4, results, backend);
+    benchmark::DoNotOptimize(results.endTime.data());
+  }
+  state.counters["workloads/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * workloads.size()),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_BatchSimulation)
+    ->ArgName("backend")
+    ->Arg(static_cast<int>(BatchBackend::Scalar))
+    ->Arg(static_cast<int>(BatchBackend::Avx2))
+    ->Arg(static_cast<int>(BatchBackend::Avx512))
+    ->Unit(benchmark::kMillisecond);
+
+// The per-instance setup the batch engine avoids
+static void BM_SchedulerPerWorkload(benchmark::State &state) {
+  const auto &workloads = tinyWorkloads();
+  for (auto _ : state) {
+    for (const auto &procs : workloads) {
+      Scheduler scheduler(new RoundRobinStrategy(4));
+      scheduler.addProcesses(procs);
+      scheduler.run();
+      benchmark::DoNotOptimize(scheduler.getCurrentTime());
+    }
+  }
+  state.counters["workloads/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * workloads.size()),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SchedulerPerWorkload)->Unit(benchmark::kMillisecond);
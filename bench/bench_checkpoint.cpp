@@ -0,0 +1,65 @@
+#include "../checkpoint.hpp"
+#include "workload.hpp"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+// Forking a continuation from a mapped checkpoint taken halfway through the
+// run, against rerunning the prefix. Args: process count.
+static void BM_CheckpointRestore(benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = state.range(0);
+  spec.burst = BurstDistribution::Exponential;
+  spec.meanBurst = 16;
+  spec.meanGap = 5;
+  const auto procs = makeWorkload(spec);
+  const unsigned int halfway = procs.back().startTime / 2;
+
+  auto *strategy = new RoundRobinStrategy(4);
+  Scheduler scheduler(strategy);
+  scheduler.addProcesses(procs);
+  strategy->runUntil(scheduler, halfway);
+  const auto path =
+      (std::filesystem::temp_directory_path() / "bench_checkpoint.bin")
+          .string();
+  Checkpoint::capture(scheduler).save(path);
+  const auto checkpoint = Checkpoint::load(path);
+
+  Scheduler fork(new RoundRobinStrategy(4));
+  for (auto _ : state) {
+    checkpoint.restore(fork);
+    benchmark::DoNotOptimize(fork.getQueue().size());
+  }
+  state.SetItemsProcessed(state.iterations() * procs.size());
+  std::filesystem::remove(path);
+}
+BENCHMARK(BM_CheckpointRestore)
+    ->ArgName("procs")
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// The prefix that a restore saves recomputing
+static void BM_RunPrefix(benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = state.range(0);
+  spec.burst = BurstDistribution::Exponential;
+  spec.meanBurst = 16;
+  spec.meanGap = 5;
+  const auto procs = makeWorkload(spec);
+  const unsigned int halfway = procs.back().startTime / 2;
+
+  auto *strategy = new RoundRobinStrategy(4);
+  Scheduler scheduler(strategy);
+  for (auto _ : state) {
+    state.PauseTiming();
+    scheduler.reset();
+    scheduler.addProcesses(procs);
+    state.ResumeTiming();
+
+    strategy->runUntil(scheduler, halfway);
+  }
+  state.SetItemsProcessed(state.iterations() * procs.size());
+}
+BENCHMARK(BM_RunPrefix)
+    ->ArgName("procs")
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
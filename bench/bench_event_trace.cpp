@@ -0,0 +1,38 @@
+#include "../event_trace.hpp"
+#include "workload.hpp"
+#include <benchmark/benchmark.h>
+
+// Round robin with and without a TraceRecorder attached.
+// Args: process count, whether to record.
+static void BM_RoundRobinTraced(benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = state.range(0);
+  spec.burst = BurstDistribution::Exponential;
+  spec.meanBurst = 16;
+  spec.meanGap = 5;
+  const auto procs = makeWorkload(spec);
+  auto *strategy = new RoundRobinStrategy(4);
+  Scheduler scheduler(strategy);
+  TraceRecorder recorder;
+  if (state.range(1) != 0) {
+    strategy->setTraceRecorder(&recorder);
+  }
+  // The first run faults in the recorder's log, which later runs reuse
+  scheduler.addProcesses(procs);
+  scheduler.run();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    scheduler.reset();
+    scheduler.addProcesses(procs);
+    state.ResumeTiming();
+
+    scheduler.run();
+  }
+  state.SetItemsProcessed(state.iterations() * procs.size());
+  state.counters["events"] = static_cast<double>(recorder.size());
+}
+BENCHMARK(BM_RoundRobinTraced)
+    ->ArgNames({"procs", "traced"})
+    ->ArgsProduct({{1000000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,33 @@
+#include "../executor.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace std::chrono_literals;
+
+static Task yieldTimes(int steps) {
+  for (int i = 0; i < steps; ++i) {
+    co_await yieldPoint();
+  }
+}
+
+// Submitting and completing many small jobs. Args: workers, quantum in us.
+// A quantum of 0 suspends at every yield point, which measures the cost of a
+// round trip through the queues.
+static void BM_ExecutorThroughput(benchmark::State &state) {
+  constexpr int jobs = 10000;
+  constexpr int steps = 16;
+  RoundRobinExecutor executor(state.range(0),
+                              std::chrono::microseconds(state.range(1)));
+
+  for (auto _ : state) {
+    for (unsigned int pid = 0; pid < jobs; ++pid) {
+      executor.submit(pid, yieldTimes(steps));
+    }
+    executor.wait();
+  }
+  state.SetItemsProcessed(state.iterations() * jobs);
+}
+BENCHMARK(BM_ExecutorThroughput)
+    ->ArgNames({"workers", "quantum_us"})
+    ->ArgsProduct({{1, 4}, {0, 100}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
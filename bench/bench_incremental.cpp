@@ -0,0 +1,59 @@
+#include "../incremental.hpp"
+#include "workload.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+
+// One process edited in a 1M-process trace: an incremental update against a
+// full rerun. Args: process count, mean gap between arrivals (16 keeps the
+// CPU about 90% busy, 8 overloads it so the queue never drains).
+static WorkloadSpec editSpec(const benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = state.range(0);
+  spec.burst = BurstDistribution::Exponential;
+  spec.meanBurst = 15;
+  spec.meanGap = state.range(1);
+  return spec;
+}
+
+static void BM_IncrementalUpdate(benchmark::State &state) {
+  auto procs = makeWorkload(editSpec(state));
+  IncrementalRoundRobin sim(4);
+  sim.addProcesses(procs);
+  sim.run();
+
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<size_t> pick(0, procs.size() - 1);
+  std::uniform_int_distribution<unsigned int> burst(1, 60);
+  size_t converged = 0;
+  for (auto _ : state) {
+    const auto &proc = procs[pick(rng)];
+    sim.updateProcess(proc.pid, proc.startTime, burst(rng));
+    converged += sim.getLastUpdate().converged;
+  }
+  state.counters["converged"] =
+      static_cast<double>(converged) / state.iterations();
+  state.counters["snapshots"] = sim.snapshotCount();
+}
+BENCHMARK(BM_IncrementalUpdate)
+    ->ArgNames({"procs", "gap"})
+    ->Args({1000000, 16})
+    ->Args({1000000, 8})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_FullRerun(benchmark::State &state) {
+  const auto procs = makeWorkload(editSpec(state));
+  Scheduler scheduler(new RoundRobinStrategy(4));
+  for (auto _ : state) {
+    state.PauseTiming();
+    scheduler.reset();
+    scheduler.addProcesses(procs);
+    state.ResumeTiming();
+
+    scheduler.run();
+  }
+}
+BENCHMARK(BM_FullRerun)
+    ->ArgNames({"procs", "gap"})
+    ->Args({1000000, 16})
+    ->Args({1000000, 8})
+    ->Unit(benchmark::kMillisecond);
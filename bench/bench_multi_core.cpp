@@ -0,0 +1,33 @@
+#include "../multi_core_strategy.hpp"
+#include "workload.hpp"
+#include <benchmark/benchmark.h>
+
+// Args: number of cores, placement policy. The arrival rate scales with the
+// core count so every configuration runs near saturation.
+static void BM_MultiCoreRoundRobin(benchmark::State &state) {
+  const auto cores = static_cast<unsigned int>(state.range(0));
+  WorkloadSpec spec;
+  spec.count = 1000000;
+  spec.burst = BurstDistribution::Exponential;
+  spec.meanBurst = 64;
+  spec.meanGap = std::max(1u, 60 / cores);
+  const auto procs = makeWorkload(spec);
+
+  Scheduler scheduler(new MultiCoreRoundRobinStrategy(
+      cores, 8, static_cast<PlacementPolicy>(state.range(1))));
+  for (auto _ : state) {
+    state.PauseTiming();
+    scheduler.reset();
+    scheduler.addProcesses(procs);
+    state.ResumeTiming();
+
+    scheduler.run();
+  }
+  state.SetItemsProcessed(state.iterations() * procs.size());
+}
+BENCHMARK(BM_MultiCoreRoundRobin)
+    ->ArgNames({"cores", "placement"})
+    ->ArgsProduct({{1, 8, 32, 128},
+                   {static_cast<int>(PlacementPolicy::RoundRobin),
+                    static_cast<int>(PlacementPolicy::LeastLoaded)}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,183 @@
+#include "../scheduler.hpp"
+#include "../simulation.hpp"
+#include "workload.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// Runs RoundRobinStrategy over `procs` once per iteration. Loading the
+// workload is excluded from the timing.
+static void runRoundRobin(benchmark::State &state,
+                          const std::vector<Process> &procs,
+                          unsigned int quantum) {
+  Scheduler scheduler(new RoundRobinStrategy(quantum));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    scheduler.reset();
+    scheduler.addProcesses(procs);
+    state.ResumeTiming();
+
+    scheduler.run();
+  }
+  state.SetItemsProcessed(state.iterations() * procs.size());
+  state.SetComplexityN(procs.size());
+}
+
+// Scaling with the number of concurrently ready processes
+static void BM_RoundRobinConcurrentReady(benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = state.range(0);
+  spec.arrival = ArrivalPattern::AllAtOnce;
+  spec.meanBurst = 32;
+  runRoundRobin(state, makeWorkload(spec), 4);
+}
+BENCHMARK(BM_RoundRobinConcurrentReady)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+
+// Args: process count, quantum, burst distribution, arrival pattern
+static void BM_RoundRobinRun(benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = state.range(0);
+  spec.burst = static_cast<BurstDistribution>(state.range(2));
+  spec.arrival = static_cast<ArrivalPattern>(state.range(3));
+  spec.meanBurst = 16;
+  spec.meanGap = 16;
+  runRoundRobin(state, makeWorkload(spec), state.range(1));
+}
+BENCHMARK(BM_RoundRobinRun)
+    ->ArgNames({"procs", "quantum", "burst", "arrival"})
+    ->ArgsProduct({{10000, 100000},
+                   {1, 4, 64},
+                   {static_cast<int>(BurstDistribution::Uniform),
+                    static_cast<int>(BurstDistribution::Exponential),
+                    static_cast<int>(BurstDistribution::Bimodal)},
+                   {static_cast<int>(ArrivalPattern::AllAtOnce),
+                    static_cast<int>(ArrivalPattern::Poisson),
+                    static_cast<int>(ArrivalPattern::Bursty)}})
+    ->Unit(benchmark::kMillisecond);
+
+// Cost of a single slice with an empty arrival list: the round-robin kernel
+// resumed for one slice at a time
+static void BM_ProcessTimeSlice(benchmark::State &state) {
+  const std::vector<unsigned int> startTime{0};
+  const std::vector<unsigned int> burstTime{4000000000u};
+  const std::vector<size_t> arrivalOrder{0};
+  const WorkloadView workload{startTime, burstTime, arrivalOrder};
+  std::vector<unsigned int> remaining = burstTime;
+  std::vector<int> end(1, -1);
+  RingBuffer<unsigned int> readyQueue;
+  RoundRobinCursor cursor;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        resumeRoundRobin(workload, remaining, end, readyQueue,
+                         RuntimeQuantum{1}, cursor, cursor.currentTime + 1));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProcessTimeSlice);
+
+// Macro benchmarks: whole synthetic traces, including loading them
+static void runTrace(benchmark::State &state, const WorkloadSpec &spec,
+                     unsigned int quantum) {
+  const auto procs = makeWorkload(spec);
+  Scheduler scheduler(new RoundRobinStrategy(quantum));
+
+  for (auto _ : state) {
+    scheduler.reset();
+    scheduler.addProcesses(procs);
+    scheduler.run();
+  }
+  state.SetItemsProcessed(state.iterations() * procs.size());
+}
+
+// Interactive service: short heavy-tailed requests arriving continuously
+static void BM_TraceInteractive(benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = 1000000;
+  spec.burst = BurstDistribution::Exponential;
+  spec.meanBurst = 8;
+  spec.meanGap = 9;
+  runTrace(state, spec, 4);
+}
+BENCHMARK(BM_TraceInteractive)->Unit(benchmark::kMillisecond);
+
+// Batch cluster: long jobs submitted in waves
+static void BM_TraceBatch(benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = 1000000;
+  spec.arrival = ArrivalPattern::Bursty;
+  spec.meanBurst = 500;
+  spec.meanGap = 450;
+  runTrace(state, spec, 50);
+}
+BENCHMARK(BM_TraceBatch)->Unit(benchmark::kMillisecond);
+
+// Mixed interactive and batch load kept close to saturation
+static void BM_TraceMixed(benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = 1000000;
+  spec.burst = BurstDistribution::Bimodal;
+  spec.meanBurst = 40;
+  spec.meanGap = 40;
+  runTrace(state, spec, 8);
+}
+BENCHMARK(BM_TraceMixed)->Unit(benchmark::kMillisecond);
+
+// Long staggered trace used to track memory-layout changes
+static void BM_RoundRobinLargeTrace(benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = state.range(0);
+  spec.meanBurst = 16;
+  spec.meanGap = 4;
+  runRoundRobin(state, makeWorkload(spec), 4);
+}
+BENCHMARK(BM_RoundRobinLargeTrace)
+    ->Arg(10000000)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+// Quantum sweep over one small workload: a fresh scheduler per quantum,
+// loading included, against one scheduler that loads the workload once and
+// reruns it with each quantum. Args: process count, reuse.
+static void BM_RerunWithQuantum(benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = state.range(0);
+  spec.meanBurst = 16;
+  spec.meanGap = 4;
+  const auto procs = makeWorkload(spec);
+  const bool reuse = state.range(1) != 0;
+
+  RoundRobinStrategy strategy(1);
+  Scheduler reused(strategy);
+  reused.addProcesses(procs);
+  unsigned int quantum = 0;
+  size_t allocations = 0;
+  for (auto _ : state) {
+    quantum = quantum % 32 + 1;
+    if (reuse) {
+      strategy.setTimeQuantum(quantum);
+      reused.run();
+    } else {
+      Scheduler fresh(new RoundRobinStrategy(quantum));
+      fresh.addProcesses(procs);
+      fresh.run();
+      allocations += fresh.getAllocationCount();
+    }
+  }
+  if (reuse) {
+    allocations = reused.getAllocationCount(); // All from the first run
+  }
+  state.counters["allocs/run"] =
+      static_cast<double>(allocations) / state.iterations();
+  state.SetItemsProcessed(state.iterations() * procs.size());
+}
+BENCHMARK(BM_RerunWithQuantum)
+    ->ArgNames({"procs", "reuse"})
+    ->ArgsProduct({{1000, 100000}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
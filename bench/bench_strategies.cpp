@@ -0,0 +1,35 @@
+#include "../scheduler.hpp"
+#include "workload.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+
+// Every strategy on the same trace, with factory defaults.
+// Args: process count, SchedulerType.
+static void BM_StrategyRun(benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = state.range(0);
+  spec.burst = BurstDistribution::Exponential;
+  spec.meanBurst = 16;
+  spec.meanGap = 5;
+  const auto procs = makeWorkload(spec);
+  std::unique_ptr<Scheduler> scheduler(
+      SchedulerFactory(static_cast<SchedulerType>(state.range(1))));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    scheduler->reset();
+    scheduler->addProcesses(procs);
+    state.ResumeTiming();
+
+    scheduler->run();
+  }
+  state.SetItemsProcessed(state.iterations() * procs.size());
+}
+BENCHMARK(BM_StrategyRun)
+    ->ArgNames({"procs", "type"})
+    ->ArgsProduct({{100000, 1000000},
+                   {static_cast<int>(SchedulerType::RoundRobin),
+                    static_cast<int>(SchedulerType::MLFQ),
+                    static_cast<int>(SchedulerType::SRTF),
+                    static_cast<int>(SchedulerType::CFS)}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,31 @@
+#include "../sweep.hpp"
+#include "workload.hpp"
+#include <benchmark/benchmark.h>
+
+// 32 quanta over a 1M-process workload; Arg is the number of worker threads
+static void BM_QuantumSweep(benchmark::State &state) {
+  WorkloadSpec spec;
+  spec.count = 1000000;
+  spec.burst = BurstDistribution::Exponential;
+  spec.meanBurst = 32;
+  spec.meanGap = 36;
+  const auto procs = makeWorkload(spec);
+  const Workload workload(procs);
+
+  const SchedulerType types[] = {SchedulerType::RoundRobin};
+  std::vector<unsigned int> quanta;
+  for (unsigned int q = 1; q <= 32; ++q) {
+    quanta.push_back(q * 2);
+  }
+  const auto points = makeSweepGrid(types, quanta);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(runSweep(workload, points, state.range(0)));
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_QuantumSweep)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
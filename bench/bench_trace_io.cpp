@@ -0,0 +1,88 @@
+#include "../trace_io.hpp"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+static constexpr size_t kTraceSize = 1000000;
+
+static std::string tracePath(TraceFormat format) {
+  const auto dir = std::filesystem::temp_directory_path();
+  return (dir / (format == TraceFormat::Binary ? "rr_bench_trace.bin"
+                                               : "rr_bench_trace.csv"))
+      .string();
+}
+
+// Writes both trace files the first time any load benchmark runs
+static void ensureTraceFiles() {
+  static const bool written = [] {
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<unsigned int> gap(0, 8);
+    std::uniform_int_distribution<unsigned int> burst(1, 1000);
+    std::vector<Process> procs;
+    procs.reserve(kTraceSize);
+    unsigned int arrival = 0;
+    for (unsigned int pid = 0; pid < kTraceSize; ++pid) {
+      arrival += gap(rng);
+      procs.emplace_back(pid, arrival, burst(rng));
+    }
+    writeBinaryTrace(tracePath(TraceFormat::Binary), procs);
+    writeCsvTrace(tracePath(TraceFormat::Csv), procs);
+    return true;
+  }();
+  (void)written;
+}
+
+// Lower bound: read the raw bytes of the file and nothing else
+static void BM_ReadFileBytes(benchmark::State &state) {
+  ensureTraceFiles();
+  const auto path = tracePath(static_cast<TraceFormat>(state.range(0)));
+  std::vector<char> buffer(1 << 20);
+
+  for (auto _ : state) {
+    FILE *in = std::fopen(path.c_str(), "rb");
+    size_t total = 0;
+    size_t got;
+    while ((got = std::fread(buffer.data(), 1, buffer.size(), in)) > 0) {
+      total += got;
+    }
+    std::fclose(in);
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          std::filesystem::file_size(path));
+}
+BENCHMARK(BM_ReadFileBytes)
+    ->Arg(static_cast<int>(TraceFormat::Binary))
+    ->Arg(static_cast<int>(TraceFormat::Csv))
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_LoadBinaryTrace(benchmark::State &state) {
+  ensureTraceFiles();
+  const auto path = tracePath(TraceFormat::Binary);
+  Scheduler scheduler(new RoundRobinStrategy(4));
+
+  for (auto _ : state) {
+    scheduler.reset();
+    loadBinaryTrace(path, scheduler);
+  }
+  state.SetItemsProcessed(state.iterations() * kTraceSize);
+  state.SetBytesProcessed(state.iterations() *
+                          std::filesystem::file_size(path));
+}
+BENCHMARK(BM_LoadBinaryTrace)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadCsvTrace(benchmark::State &state) {
+  ensureTraceFiles();
+  const auto path = tracePath(TraceFormat::Csv);
+  Scheduler scheduler(new RoundRobinStrategy(4));
+
+  for (auto _ : state) {
+    scheduler.reset();
+    loadCsvTrace(path, scheduler);
+  }
+  state.SetItemsProcessed(state.iterations() * kTraceSize);
+  state.SetBytesProcessed(state.iterations() *
+                          std::filesystem::file_size(path));
+}
+BENCHMARK(BM_LoadCsvTrace)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../scheduler.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Synthetic workload generator shared by the benchmarks
+
+enum class BurstDistribution {
+  Uniform,     // Uniform in [1, 2 * mean]
+  Exponential, // Many short bursts, long tail
+  Bimodal      // 90% short interactive bursts, 10% long batch bursts
+};
+
+enum class ArrivalPattern {
+  AllAtOnce, // Everything ready at t=0
+  Poisson,   // Exponential inter-arrival gaps
+  Bursty     // Clusters of simultaneous arrivals separated by long gaps
+};
+
+struct WorkloadSpec {
+  size_t count = 1000;
+  BurstDistribution burst = BurstDistribution::Uniform;
+  ArrivalPattern arrival = ArrivalPattern::Poisson;
+  unsigned int meanBurst = 16;
+  unsigned int meanGap = 4; // Mean time between arrivals
+  uint32_t seed = 1;
+};
+
+inline std::vector<Process> makeWorkload(const WorkloadSpec &spec) {
+  std::mt19937 rng(spec.seed);
+  std::uniform_int_distribution<unsigned int> uniformBurst(
+      1, std::max(1u, spec.meanBurst * 2));
+  std::exponential_distribution<double> expBurst(1.0 / spec.meanBurst);
+  std::exponential_distribution<double> expGap(1.0 / std::max(1u, spec.meanGap));
+  std::bernoulli_distribution isLong(0.1);
+  std::uniform_int_distribution<unsigned int> clusterSize(1, 64);
+
+  auto nextBurst = [&]() -> unsigned int {
+    switch (spec.burst) {
+    case BurstDistribution::Exponential:
+      return 1 + static_cast<unsigned int>(expBurst(rng));
+    case BurstDistribution::Bimodal:
+      return isLong(rng) ? spec.meanBurst * 8 : 1 + spec.meanBurst / 8;
+    default:
+      return uniformBurst(rng);
+    }
+  };
+
+  std::vector<Process> procs;
+  procs.reserve(spec.count);
+  uint64_t arrival = 0;
+  unsigned int leftInCluster = 0;
+  for (size_t pid = 0; pid < spec.count; ++pid) {
+    switch (spec.arrival) {
+    case ArrivalPattern::Poisson:
+      arrival += static_cast<uint64_t>(expGap(rng));
+      break;
+    case ArrivalPattern::Bursty:
+      if (leftInCluster == 0) {
+        leftInCluster = clusterSize(rng);
+        // Keep the long-run arrival rate equal to the Poisson pattern
+        arrival += static_cast<uint64_t>(leftInCluster) * spec.meanGap;
+      }
+      leftInCluster--;
+      break;
+    default:
+      break;
+    }
+    procs.emplace_back(static_cast<unsigned int>(pid),
+                       static_cast<unsigned int>(arrival), nextBurst());
+  }
+  return procs;
+}
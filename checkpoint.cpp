@@ -0,0 +1,179 @@
+#include "checkpoint.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kCheckpointMagic[8] = {'R', 'R', 'C', 'K', 'P', 'T', '\0', '\0'};
+constexpr uint32_t kCheckpointVersion = 2; // 1 also stored the PID map
+
+// Columns before the ready queue
+enum Column : size_t {
+  PidColumn,
+  StartColumn,
+  BurstColumn,
+  RemainingColumn,
+  EndColumn,
+  OrderColumn,
+  ColumnCount
+};
+
+static_assert(sizeof(CheckpointHeader) % sizeof(uint32_t) == 0);
+constexpr size_t kHeaderWords = sizeof(CheckpointHeader) / sizeof(uint32_t);
+
+size_t bodyWords(const CheckpointHeader &header) {
+  return ColumnCount * header.processCount + header.queueLength;
+}
+
+} // namespace
+
+std::span<const uint32_t> Checkpoint::column(size_t n) const {
+  return {columns + n * header->processCount, header->processCount};
+}
+
+Checkpoint Checkpoint::capture(Scheduler &scheduler) {
+  const auto &progress = scheduler.getProgress();
+  if (!progress.paused()) {
+    throw std::invalid_argument("Scheduler has no paused run to checkpoint.");
+  }
+  const auto &procs = scheduler.getProcesses();
+  const auto &queue = scheduler.getQueue();
+  const size_t n = procs.size();
+
+  CheckpointHeader header{};
+  std::memcpy(header.magic, kCheckpointMagic, sizeof(kCheckpointMagic));
+  header.version = kCheckpointVersion;
+  header.currentTime = scheduler.getCurrentTime();
+  header.processCount = n;
+  header.nextArrival = progress.nextArrival;
+  header.queueLength = queue.size();
+  Checkpoint checkpoint;
+  checkpoint.owned.resize(kHeaderWords + bodyWords(header));
+  std::memcpy(checkpoint.owned.data(), &header, sizeof(header));
+
+  uint32_t *out = checkpoint.owned.data() + kHeaderWords;
+  auto copyColumn = [&out, n](const auto &values) {
+    std::memcpy(out, values.data(), n * sizeof(uint32_t));
+    out += n;
+  };
+  copyColumn(procs.pid);
+  copyColumn(procs.startTime);
+  copyColumn(procs.burstTime);
+  copyColumn(procs.remainingTime);
+  copyColumn(procs.endTime);
+  for (const auto idx : progress.arrivalOrder) {
+    *out++ = static_cast<uint32_t>(idx);
+  }
+  for (const auto idx : queue) {
+    *out++ = idx;
+  }
+
+  checkpoint.header =
+      reinterpret_cast<const CheckpointHeader *>(checkpoint.owned.data());
+  checkpoint.columns = checkpoint.owned.data() + kHeaderWords;
+  return checkpoint;
+}
+
+Checkpoint Checkpoint::load(const std::string &path) {
+  Checkpoint checkpoint;
+  checkpoint.mapped = std::make_unique<MappedFile>(path);
+  const auto &file = *checkpoint.mapped;
+  if (file.size() < sizeof(CheckpointHeader)) {
+    throw std::runtime_error("Truncated file: " + path);
+  }
+  const auto *header = reinterpret_cast<const CheckpointHeader *>(file.bytes());
+  const bool magicMatches = std::memcmp(header->magic, kCheckpointMagic,
+                                        sizeof(kCheckpointMagic)) == 0;
+  if (!magicMatches || header->version != kCheckpointVersion) {
+    throw std::runtime_error("Not a checkpoint: " + path);
+  }
+  // Bound the counts by the file before sizing anything from them, so the
+  // size check below cannot overflow
+  const uint64_t words = (file.size() - sizeof(CheckpointHeader)) /
+                         sizeof(uint32_t);
+  if (header->processCount > words / ColumnCount ||
+      header->queueLength > header->processCount ||
+      header->nextArrival > header->processCount) {
+    throw std::runtime_error("Truncated file: " + path);
+  }
+  const size_t n = header->processCount;
+  if (file.size() !=
+      sizeof(CheckpointHeader) + bodyWords(*header) * sizeof(uint32_t)) {
+    throw std::runtime_error("Truncated file: " + path);
+  }
+  checkpoint.header = header;
+  checkpoint.columns = reinterpret_cast<const uint32_t *>(header + 1);
+
+  // Indices are used unchecked once restored
+  const uint32_t *indices = checkpoint.columns + OrderColumn * n;
+  for (size_t i = 0; i < n + header->queueLength; ++i) {
+    if (indices[i] >= n) {
+      throw std::runtime_error("Not a checkpoint: " + path);
+    }
+  }
+  return checkpoint;
+}
+
+void Checkpoint::save(const std::string &path) const {
+  const std::string temporary = path + ".tmp";
+  std::FILE *out = std::fopen(temporary.c_str(), "wb");
+  if (out == nullptr) {
+    throw std::runtime_error("Cannot open file: " + temporary);
+  }
+  const size_t bytes =
+      sizeof(CheckpointHeader) + bodyWords(*header) * sizeof(uint32_t);
+  const bool written = std::fwrite(header, 1, bytes, out) == bytes &&
+                       std::fflush(out) == 0 && ::fsync(::fileno(out)) == 0;
+  if (std::fclose(out) != 0 || !written) {
+    std::remove(temporary.c_str());
+    throw std::runtime_error("Error writing file: " + temporary);
+  }
+  std::filesystem::rename(temporary, path);
+}
+
+void Checkpoint::restore(Scheduler &scheduler) const {
+  scheduler.reset();
+  // The checkpoint does not record when its run began, so a rerun after the
+  // restored run finishes starts from time 0
+  scheduler.beginRun();
+  const size_t n = size();
+  auto &procs = scheduler.getProcesses();
+  procs.reserve(n);
+  const auto assign = [](auto &values, std::span<const uint32_t> column) {
+    values.assign(column.begin(), column.end());
+  };
+  assign(procs.pid, column(PidColumn));
+  assign(procs.startTime, column(StartColumn));
+  assign(procs.burstTime, column(BurstColumn));
+  assign(procs.remainingTime, column(RemainingColumn));
+  assign(procs.endTime, column(EndColumn));
+  procs.waitingTime.assign(n, 0);
+  procs.deriveWaitingTimes();
+
+  auto &pidMap = scheduler.getPIDToVecIndex();
+  pidMap.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    pidMap.insert_or_assign(procs.pid[i], static_cast<int>(i));
+  }
+
+  auto &queue = scheduler.getQueue();
+  queue.reserve(n);
+  for (const auto idx : std::span(columns + ColumnCount * n, queueLength())) {
+    queue.push_back(idx);
+  }
+
+  auto &progress = scheduler.getProgress();
+  assign(progress.arrivalOrder, column(OrderColumn));
+  progress.nextArrival = header->nextArrival;
+  progress.active = true;
+  scheduler.setCurrentTime(header->currentTime);
+}
+
+unsigned int Checkpoint::getCurrentTime() const { return header->currentTime; }
+
+size_t Checkpoint::size() const { return header->processCount; }
+
+size_t Checkpoint::queueLength() const { return header->queueLength; }
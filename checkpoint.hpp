@@ -0,0 +1,67 @@
+#pragma once
+
+#include "mapped_file.hpp"
+#include "scheduler.hpp"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+// Snapshots of a paused round-robin run (RoundRobinStrategy::runUntil), to
+// resume a long replay after a crash or to fork many continuations from one
+// shared prefix.
+
+// Checkpoint layout (native byte order):
+//   CheckpointHeader, then `processCount` values of each column in turn: pid,
+//   startTime, burstTime, remainingTime (uint32), endTime (int32) and
+//   arrivalOrder (uint32), then `queueLength` uint32 ready-queue entries from
+//   front to back. Every array is 4-byte aligned, so a mapped file is used
+//   in place. Waiting times and the PID map are rebuilt on restore, so the
+//   file does not depend on how FlatPidMap hashes.
+struct CheckpointHeader {
+  char magic[8]; // "RRCKPT\0\0"
+  uint32_t version;
+  uint32_t currentTime;
+  uint64_t processCount;
+  uint64_t nextArrival;
+  uint64_t queueLength;
+};
+
+// A checkpoint is one block in the file layout, either built in memory by
+// capture() or mapped from disk by load(), so both are restored the same way.
+// Read-only once made, so one checkpoint can be restored into many
+// schedulers, from any number of threads.
+class Checkpoint {
+private:
+  std::vector<uint32_t> owned; // Backs a captured checkpoint
+  std::unique_ptr<MappedFile> mapped;
+  const CheckpointHeader *header = nullptr;
+  const uint32_t *columns = nullptr;
+
+  Checkpoint() = default;
+  std::span<const uint32_t> column(size_t n) const;
+
+public:
+  Checkpoint(Checkpoint &&) = default;
+  Checkpoint &operator=(Checkpoint &&) = default;
+
+  // Copies the state of `scheduler`, whose run must be paused
+  static Checkpoint capture(Scheduler &scheduler);
+  // Maps a checkpoint written by save(). Throws std::runtime_error if the file
+  // is not a valid checkpoint.
+  static Checkpoint load(const std::string &path);
+
+  // Writes to a temporary file and renames it over `path`, so a crash while
+  // saving leaves the previous checkpoint intact
+  void save(const std::string &path) const;
+
+  // Replaces the processes, ready queue and time of `scheduler`, leaving its
+  // run paused where the checkpoint was taken. Continue it with a
+  // RoundRobinStrategy.
+  void restore(Scheduler &scheduler) const;
+
+  unsigned int getCurrentTime() const;
+  size_t size() const; // Number of processes
+  size_t queueLength() const;
+};
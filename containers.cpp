@@ -0,0 +1,88 @@
+#include "containers.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+// FlatPidMap
+size_t FlatPidMap::slotFor(unsigned int pid) const {
+  // Fibonacci hashing. The slot comes from the high bits of the product,
+  // which depend on every bit of the PID; the low bits only depend on the
+  // PID's low bits, so strided PIDs would share a handful of slots.
+  const uint64_t hash = static_cast<uint64_t>(pid) * 11400714819323198485ull;
+  return static_cast<size_t>(hash >> (64 - std::countr_zero(slots.size())));
+}
+
+void FlatPidMap::rehash(size_t newSlotCount) {
+  std::pmr::vector<Slot> old(newSlotCount, Slot{0, -1}, slots.get_allocator());
+  old.swap(slots);
+  count = 0;
+  for (const auto &slot : old) {
+    if (slot.index >= 0) {
+      insert_or_assign(slot.pid, slot.index);
+    }
+  }
+}
+
+void FlatPidMap::reserve(size_t n) {
+  // Keep the load factor at or below 1/2
+  size_t needed = 16;
+  while (needed < n * 2) {
+    needed *= 2;
+  }
+  if (needed > slots.size()) {
+    rehash(needed);
+  }
+}
+
+void FlatPidMap::insert_or_assign(unsigned int pid, int index) {
+  if ((count + 1) * 2 > slots.size()) {
+    rehash(slots.empty() ? 16 : slots.size() * 2);
+  }
+
+  const size_t mask = slots.size() - 1;
+  for (size_t i = slotFor(pid);; i = (i + 1) & mask) {
+    if (slots[i].index < 0) {
+      slots[i] = Slot{pid, index};
+      count++;
+      return;
+    }
+    if (slots[i].pid == pid) {
+      slots[i].index = index;
+      return;
+    }
+  }
+}
+
+const int *FlatPidMap::find(unsigned int pid) const {
+  if (slots.empty()) {
+    return nullptr;
+  }
+
+  const size_t mask = slots.size() - 1;
+  for (size_t i = slotFor(pid);; i = (i + 1) & mask) {
+    if (slots[i].index < 0) {
+      return nullptr;
+    }
+    if (slots[i].pid == pid) {
+      return &slots[i].index;
+    }
+  }
+}
+
+size_t FlatPidMap::longestCluster() const {
+  size_t longest = 0;
+  size_t run = 0;
+  // Twice round, so a cluster that wraps past the end is counted whole
+  for (size_t i = 0; i < 2 * slots.size(); ++i) {
+    run = slots[i & (slots.size() - 1)].index >= 0 ? run + 1 : 0;
+    longest = std::max(longest, run);
+  }
+  return std::min(longest, slots.size());
+}
+
+void FlatPidMap::clear() {
+  for (auto &slot : slots) {
+    slot.index = -1;
+  }
+  count = 0;
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+// Memory resource that counts the allocations it passes on to `upstream`.
+// Not thread-safe, like the containers it backs.
+class CountingResource : public std::pmr::memory_resource {
+private:
+  std::pmr::memory_resource *upstream;
+  size_t allocations = 0;
+  size_t bytesInUse = 0;
+
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    void *ptr = upstream->allocate(bytes, alignment);
+    allocations++;
+    bytesInUse += bytes;
+    return ptr;
+  }
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+    upstream->deallocate(ptr, bytes, alignment);
+    bytesInUse -= bytes;
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+public:
+  explicit CountingResource(
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+      : upstream(upstream) {}
+
+  size_t allocationCount() const { return allocations; }
+  size_t bytesAllocated() const { return bytesInUse; }
+};
+
+// Fixed-capacity FIFO backed by a single contiguous buffer. Capacity is set up
+// front with reserve() so pushing and popping never touch the heap; push_back
+// only grows the buffer if a caller exceeds the reserved capacity.
+template <typename T> class RingBuffer {
+private:
+  std::pmr::vector<T> buffer; // Always cap elements
+  size_t cap = 0;
+  size_t head = 0;
+  size_t count = 0;
+
+  void grow(size_t newCap) {
+    std::pmr::vector<T> bigger(newCap, buffer.get_allocator());
+    for (size_t i = 0; i < count; ++i) {
+      bigger[i] = (*this)[i];
+    }
+    buffer.swap(bigger);
+    cap = newCap;
+    head = 0;
+  }
+
+public:
+  RingBuffer() = default;
+  explicit RingBuffer(std::pmr::memory_resource *resource) : buffer(resource) {}
+
+  class const_iterator {
+  private:
+    const RingBuffer *ring;
+    size_t pos;
+
+  public:
+    const_iterator(const RingBuffer *ring, size_t pos) : ring(ring), pos(pos) {}
+    const T &operator*() const { return (*ring)[pos]; }
+    const_iterator &operator++() {
+      ++pos;
+      return *this;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return pos != other.pos;
+    }
+  };
+
+  void reserve(size_t newCap) {
+    if (newCap > cap) {
+      grow(newCap);
+    }
+  }
+
+  void push_back(const T &value) {
+    if (count == cap) {
+      grow(cap == 0 ? 16 : cap * 2);
+    }
+    size_t tail = head + count;
+    if (tail >= cap) {
+      tail -= cap;
+    }
+    buffer[tail] = value;
+    count++;
+  }
+
+  void pop_front() {
+    if (++head == cap) {
+      head = 0;
+    }
+    count--;
+  }
+
+  T &front() { return buffer[head]; }
+  const T &front() const { return buffer[head]; }
+
+  const T &operator[](size_t i) const {
+    size_t pos = head + i;
+    return buffer[pos >= cap ? pos - cap : pos];
+  }
+
+  size_t size() const { return count; }
+  size_t capacity() const { return cap; }
+  bool empty() const { return count == 0; }
+
+  // Keeps the buffer so the next run does not need to allocate again
+  void clear() {
+    head = 0;
+    count = 0;
+  }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, count); }
+};
+
+// Open-addressing hash map from PID to index in the process vector. Linear
+// probing over one flat array keeps lookups to a couple of cache lines.
+class FlatPidMap {
+private:
+  struct Slot {
+    unsigned int pid;
+    int index; // -1 marks an empty slot
+  };
+
+  std::pmr::vector<Slot> slots;
+  size_t count = 0;
+
+  size_t slotFor(unsigned int pid) const;
+  void rehash(size_t newSlotCount);
+
+public:
+  FlatPidMap() = default;
+  explicit FlatPidMap(std::pmr::memory_resource *resource) : slots(resource) {}
+
+  void reserve(size_t n);
+  void insert_or_assign(unsigned int pid, int index);
+  const int *find(unsigned int pid) const;
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  void clear();
+  // Longest run of occupied slots, which bounds the probes of any lookup
+  size_t longestCluster() const;
+};
+
+// Bounded lock-free multi-producer multi-consumer queue (Dmitry Vyukov's
+// design). Each cell carries a sequence number that tells producers and
+// consumers whether it is free for their lap around the buffer, so a push or
+// pop is one CAS on the shared index plus a release store on the cell.
+template <typename T> class BoundedMpmcQueue {
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> cells;
+  size_t mask;
+  alignas(64) std::atomic<size_t> enqueuePos{0};
+  alignas(64) std::atomic<size_t> dequeuePos{0};
+
+public:
+  // capacity must be a power of two
+  explicit BoundedMpmcQueue(size_t capacity)
+      : cells(new Cell[capacity]), mask(capacity - 1) {
+    if (capacity < 2 || (capacity & mask) != 0) {
+      throw std::invalid_argument("Queue capacity must be a power of two.");
+    }
+    for (size_t i = 0; i < capacity; ++i) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Returns false if the queue is full
+  bool try_push(const T &value) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells[pos & mask];
+      const size_t seq = cell.sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+          cell.value = value;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Returns false if the queue is empty
+  bool try_pop(T &value) {
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells[pos & mask];
+      const size_t seq = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+          value = cell.value;
+          cell.sequence.store(pos + mask + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  size_t capacity() const { return mask + 1; }
+};
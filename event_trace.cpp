@@ -0,0 +1,254 @@
+#include "event_trace.hpp"
+#include "simulation.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace {
+
+constexpr char kEventLogMagic[8] = {'R', 'R', 'E', 'V', 'L', 'O', 'G', '\0'};
+constexpr char kResultMagic[8] = {'R', 'R', 'C', 'O', 'L', 'S', '\0', '\0'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kEventLogVersion = 2; // 1 stored the events themselves
+constexpr uint32_t kResultColumns = 5;
+
+// Closes the file on scope exit
+struct FileCloser {
+  void operator()(std::FILE *file) const { std::fclose(file); }
+};
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+FilePtr openFile(const std::string &path, const char *mode) {
+  FilePtr file(std::fopen(path.c_str(), mode));
+  if (!file) {
+    throw std::runtime_error("Cannot open file: " + path);
+  }
+  return file;
+}
+
+void writeAll(std::FILE *out, const void *data, size_t size, size_t count) {
+  if (count > 0 && std::fwrite(data, size, count, out) != count) {
+    throw std::runtime_error("Error writing file");
+  }
+}
+
+void readAll(std::FILE *in, void *data, size_t size, size_t count) {
+  if (count > 0 && std::fread(data, size, count, in) != count) {
+    throw std::runtime_error("Truncated file");
+  }
+}
+
+} // namespace
+
+// TraceRecorder
+TraceRecorder::Queue TraceRecorder::begin(
+    std::span<const unsigned int> startTime,
+    std::span<const unsigned int> burstTime, unsigned int newQuantum,
+    unsigned int time) {
+  if (newQuantum == 0) {
+    throw std::invalid_argument("Time quantum must be positive.");
+  }
+  if (startTime.size() > TraceEvent::maxIndex) {
+    throw std::invalid_argument("Too many processes to record a trace.");
+  }
+  // Every push is logged, and there is one per slice. Each process has at
+  // most one slice shorter than the quantum.
+  uint64_t totalBurst = 0;
+  for (const auto burst : burstTime) {
+    totalBurst += burst;
+  }
+  const size_t maxSlices = totalBurst / newQuantum + burstTime.size();
+  if (log.size() < maxSlices) {
+    log.resize(maxSlices);
+  }
+  slices = 0;
+  startTimes.assign(startTime.begin(), startTime.end());
+  burstTimes.assign(burstTime.begin(), burstTime.end());
+  quantum = newQuantum;
+  beginTime = time;
+  return Queue(log.data());
+}
+
+void TraceRecorder::clear() {
+  slices = 0;
+  startTimes.clear();
+  burstTimes.clear();
+}
+
+std::vector<size_t> TraceRecorder::arrivalOrder() const {
+  return sortByArrival(startTimes);
+}
+
+std::vector<TraceEvent> TraceRecorder::events() const {
+  std::vector<TraceEvent> all;
+  all.reserve(startTimes.size() + 2 * slices);
+  forEach([&all](const TraceEvent &event) { all.push_back(event); });
+  return all;
+}
+
+// Event log
+void writeEventLog(const std::string &path, const TraceRecorder &recorder,
+                   std::span<const unsigned int> pids) {
+  const auto startTimes = recorder.getStartTimes();
+  const auto burstTimes = recorder.getBurstTimes();
+  const auto dispatches = recorder.getDispatches();
+  if (pids.size() != startTimes.size()) {
+    throw std::invalid_argument("Need one PID per recorded process.");
+  }
+  auto out = openFile(path, "wb");
+  EventLogHeader header{};
+  std::memcpy(header.magic, kEventLogMagic, sizeof(kEventLogMagic));
+  header.version = kEventLogVersion;
+  header.quantum = recorder.getQuantum();
+  header.beginTime = recorder.getBeginTime();
+  header.processCount = static_cast<uint32_t>(pids.size());
+  header.sliceCount = dispatches.size();
+  writeAll(out.get(), &header, sizeof(header), 1);
+  writeAll(out.get(), pids.data(), sizeof(unsigned int), pids.size());
+  writeAll(out.get(), startTimes.data(), sizeof(unsigned int),
+           startTimes.size());
+  writeAll(out.get(), burstTimes.data(), sizeof(unsigned int),
+           burstTimes.size());
+  writeAll(out.get(), dispatches.data(), sizeof(uint32_t), dispatches.size());
+  if (std::fflush(out.get()) != 0) {
+    throw std::runtime_error("Error writing file");
+  }
+}
+
+EventLog readEventLog(const std::string &path) {
+  auto in = openFile(path, "rb");
+  EventLogHeader header{};
+  readAll(in.get(), &header, sizeof(header), 1);
+  if (std::memcmp(header.magic, kEventLogMagic, sizeof(kEventLogMagic)) != 0 ||
+      header.version != kEventLogVersion || header.quantum == 0 ||
+      header.processCount > TraceEvent::maxIndex) {
+    throw std::runtime_error("Not an event log: " + path);
+  }
+  // Bound the counts by the file before allocating for them
+  const uint64_t words =
+      (std::filesystem::file_size(path) - sizeof(header)) / sizeof(uint32_t);
+  if (header.sliceCount > words ||
+      3 * uint64_t{header.processCount} > words - header.sliceCount) {
+    throw std::runtime_error("Truncated file");
+  }
+
+  const size_t n = header.processCount;
+  EventLog log;
+  log.pids.resize(n);
+  std::vector<unsigned int> startTime(n), burstTime(n);
+  std::vector<uint32_t> dispatches(header.sliceCount);
+  readAll(in.get(), log.pids.data(), sizeof(unsigned int), n);
+  readAll(in.get(), startTime.data(), sizeof(unsigned int), n);
+  readAll(in.get(), burstTime.data(), sizeof(unsigned int), n);
+  readAll(in.get(), dispatches.data(), sizeof(uint32_t), dispatches.size());
+  // The replay indexes by these unchecked
+  for (const auto idx : dispatches) {
+    if (idx >= n) {
+      throw std::runtime_error("Not an event log: " + path);
+    }
+  }
+
+  log.events.reserve(n + 2 * dispatches.size());
+  replayRoundRobin(startTime, burstTime, sortByArrival(startTime), dispatches,
+                   header.quantum, header.beginTime,
+                   [&log](const TraceEvent &e) { log.events.push_back(e); });
+  return log;
+}
+
+// Columnar results
+void writeResultColumns(const std::string &path, const ProcessTable &procs) {
+  auto out = openFile(path, "wb");
+  ResultColumnsHeader header{};
+  std::memcpy(header.magic, kResultMagic, sizeof(kResultMagic));
+  header.version = kFormatVersion;
+  header.columnCount = kResultColumns;
+  header.rowCount = procs.size();
+  writeAll(out.get(), &header, sizeof(header), 1);
+
+  // The table is already stored by column, so each one is a single write
+  const size_t n = procs.size();
+  writeAll(out.get(), procs.pid.data(), sizeof(unsigned int), n);
+  writeAll(out.get(), procs.startTime.data(), sizeof(unsigned int), n);
+  writeAll(out.get(), procs.burstTime.data(), sizeof(unsigned int), n);
+  writeAll(out.get(), procs.endTime.data(), sizeof(int), n);
+  writeAll(out.get(), procs.waitingTime.data(), sizeof(int), n);
+  if (std::fflush(out.get()) != 0) {
+    throw std::runtime_error("Error writing file");
+  }
+}
+
+std::vector<Process> readResultColumns(const std::string &path) {
+  auto in = openFile(path, "rb");
+  ResultColumnsHeader header{};
+  readAll(in.get(), &header, sizeof(header), 1);
+  if (std::memcmp(header.magic, kResultMagic, sizeof(kResultMagic)) != 0 ||
+      header.version != kFormatVersion ||
+      header.columnCount != kResultColumns) {
+    throw std::runtime_error("Not a result file: " + path);
+  }
+  // Bound the row count by the file before allocating for it
+  const uint64_t words =
+      (std::filesystem::file_size(path) - sizeof(header)) / sizeof(uint32_t);
+  if (header.rowCount > words / kResultColumns) {
+    throw std::runtime_error("Truncated file");
+  }
+
+  const size_t n = header.rowCount;
+  std::vector<unsigned int> pid(n), startTime(n), burstTime(n);
+  std::vector<int> endTime(n), waitingTime(n);
+  readAll(in.get(), pid.data(), sizeof(unsigned int), n);
+  readAll(in.get(), startTime.data(), sizeof(unsigned int), n);
+  readAll(in.get(), burstTime.data(), sizeof(unsigned int), n);
+  readAll(in.get(), endTime.data(), sizeof(int), n);
+  readAll(in.get(), waitingTime.data(), sizeof(int), n);
+
+  std::vector<Process> procs;
+  procs.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    procs.emplace_back(pid[i], startTime[i], burstTime[i]);
+    procs.back().endTime = endTime[i];
+    procs.back().waitingTime = waitingTime[i];
+  }
+  return procs;
+}
+
+// Chrome trace
+void writeChromeTrace(std::ostream &out, const TraceRecorder &recorder,
+                      std::span<const unsigned int> pids) {
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+  out << R"({"name": "thread_name", "ph": "M", "pid": 0, "tid": 0, )"
+      << R"("args": {"name": "CPU"}})";
+
+  // One CPU, so at most one slice is open at a time
+  uint32_t openIdx = 0;
+  uint32_t openStart = 0;
+  recorder.forEach([&](const TraceEvent &event) {
+    const unsigned int pid = pids[event.index()];
+    switch (event.type()) {
+    case TraceEventType::Dispatch:
+      openIdx = event.index();
+      openStart = event.time;
+      break;
+    case TraceEventType::Preempt:
+    case TraceEventType::Complete:
+      if (event.index() == openIdx) {
+        out << ",\n{\"name\": \"P" << pid
+            << R"(", "ph": "X", "pid": 0, "tid": 0, "ts": )" << openStart
+            << ", \"dur\": " << event.time - openStart << '}';
+      }
+      if (event.type() == TraceEventType::Complete) {
+        out << ",\n{\"name\": \"complete P" << pid
+            << R"(", "ph": "i", "s": "t", "pid": 0, "tid": 0, "ts": )"
+            << event.time << '}';
+      }
+      break;
+    case TraceEventType::Arrival:
+      out << ",\n{\"name\": \"arrive P" << pid
+          << R"(", "ph": "i", "s": "t", "pid": 0, "tid": 0, "ts": )"
+          << event.time << '}';
+      break;
+    }
+  });
+  out << "\n]}\n";
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "scheduler.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+// Recording of the schedule itself: every arrival, dispatch, preemption and
+// completion, plus exports of the events and of the per-process results.
+
+enum class TraceEventType : uint8_t { Arrival, Dispatch, Preempt, Complete };
+
+// 8 bytes per event: the time, and the process index (into the scheduler's
+// ProcessTable) with the event type in the top two bits
+struct TraceEvent {
+  static constexpr uint32_t indexBits = 30;
+  static constexpr uint32_t maxIndex = (uint32_t{1} << indexBits) - 1;
+
+  uint32_t time;
+  uint32_t word;
+
+  TraceEventType type() const {
+    return static_cast<TraceEventType>(word >> indexBits);
+  }
+  uint32_t index() const { return word & maxIndex; }
+};
+
+// Calls fn(const TraceEvent &) for every event of a round-robin run, rebuilt
+// from the order of its dispatches. Each dispatch starts when the slice before
+// it ended, or when the process arrives if the CPU was idle, and runs for the
+// quantum or the rest of the burst. Processes arrive at their start time, in
+// arrival order, and the kernel queues every one that has arrived by the time
+// it next dispatches or ends a slice, so they go just before that event.
+template <typename Fn>
+void replayRoundRobin(std::span<const unsigned int> startTime,
+                      std::span<const unsigned int> burstTime,
+                      std::span<const size_t> arrivalOrder,
+                      std::span<const uint32_t> dispatches,
+                      unsigned int quantum, unsigned int time, Fn &&fn) {
+  auto emit = [&fn](TraceEventType type, unsigned int at, uint32_t idx) {
+    fn(TraceEvent{at, static_cast<uint32_t>(type) << TraceEvent::indexBits |
+                          idx});
+  };
+  size_t nextArrival = 0;
+  auto arriveBy = [&](unsigned int now) {
+    while (nextArrival < arrivalOrder.size() &&
+           startTime[arrivalOrder[nextArrival]] <= now) {
+      const auto idx = static_cast<uint32_t>(arrivalOrder[nextArrival++]);
+      emit(TraceEventType::Arrival, startTime[idx], idx);
+    }
+  };
+
+  std::vector<unsigned int> remaining(burstTime.begin(), burstTime.end());
+  for (const uint32_t idx : dispatches) {
+    time = std::max(time, startTime[idx]);
+    arriveBy(time);
+    emit(TraceEventType::Dispatch, time, idx);
+    const unsigned int length = std::min(quantum, remaining[idx]);
+    remaining[idx] -= length;
+    time += length;
+    arriveBy(time);
+    emit(remaining[idx] > 0 ? TraceEventType::Preempt
+                            : TraceEventType::Complete,
+         time, idx);
+  }
+}
+
+// Records a round-robin run as the order of its dispatches, 4 bytes per
+// slice, plus a copy of the start and burst times. The run uses the recorder's
+// Queue as its ready queue: an append-only array in which every process is
+// pushed once per slice and popped once per dispatch, so the queue's contents
+// are the log and recording adds no work to the scheduling loop. The array is
+// kept by clear(), so a reused recorder does not allocate. forEach() rebuilds
+// every arrival, dispatch, preemption and completion with replayRoundRobin.
+class TraceRecorder {
+private:
+  std::vector<uint32_t> log; // Never shrinks; only `slices` are in use
+  size_t slices = 0;
+  std::vector<unsigned int> startTimes;
+  std::vector<unsigned int> burstTimes;
+  unsigned int quantum = 1;
+  unsigned int beginTime = 0;
+
+  std::vector<size_t> arrivalOrder() const;
+
+public:
+  // Ready queue for a recorded run, writing straight into the log. It never
+  // checks for room: begin() sizes the log for every slice the run can have.
+  class Queue {
+  private:
+    uint32_t *log;
+    size_t head = 0;
+    size_t tail = 0;
+
+    friend class TraceRecorder;
+    explicit Queue(uint32_t *log) : log(log) {}
+
+  public:
+    void reserve(size_t) {}
+    void push_back(unsigned int idx) { log[tail++] = idx; }
+    void pop_front() { head++; }
+    unsigned int front() const { return log[head]; }
+    bool empty() const { return head == tail; }
+    size_t size() const { return tail - head; }
+  };
+
+  // Drops the recorded run and returns the ready queue for the next one, which
+  // runs `startTime`/`burstTime` (by process index) from `time`. Throws
+  // std::invalid_argument if the quantum is 0 or there are more processes
+  // than a TraceEvent can index.
+  Queue begin(std::span<const unsigned int> startTime,
+              std::span<const unsigned int> burstTime, unsigned int quantum,
+              unsigned int time);
+  // Keeps the dispatches `queue` logged. The run must have finished.
+  void end(const Queue &queue) { slices = queue.tail; }
+  // Drops the recorded run but keeps the log's memory
+  void clear();
+
+  // Slices recorded. forEach() yields an arrival per process and a dispatch
+  // plus a preemption or completion per slice.
+  size_t size() const { return slices; }
+  bool empty() const { return slices == 0; }
+  std::span<const uint32_t> getDispatches() const {
+    return {log.data(), slices};
+  }
+  std::span<const unsigned int> getStartTimes() const { return startTimes; }
+  std::span<const unsigned int> getBurstTimes() const { return burstTimes; }
+  unsigned int getQuantum() const { return quantum; }
+  unsigned int getBeginTime() const { return beginTime; }
+
+  // Calls fn(const TraceEvent &) for every event in the order it happened
+  template <typename Fn> void forEach(Fn &&fn) const {
+    const auto order = arrivalOrder();
+    replayRoundRobin(startTimes, burstTimes, order, getDispatches(), quantum,
+                     beginTime, fn);
+  }
+  std::vector<TraceEvent> events() const;
+};
+
+// Binary event log layout (native byte order): EventLogHeader, then
+// `processCount` uint32 PIDs, start times and burst times in turn, all indexed
+// by process index, then `sliceCount` uint32 process indices in dispatch
+// order. readEventLog() replays them into events.
+struct EventLogHeader {
+  char magic[8]; // "RREVLOG\0"
+  uint32_t version;
+  uint32_t quantum;
+  uint32_t beginTime;
+  uint32_t processCount;
+  uint64_t sliceCount;
+};
+
+struct EventLog {
+  std::vector<unsigned int> pids;
+  std::vector<TraceEvent> events;
+};
+
+// Throws std::invalid_argument unless there is one PID per recorded process
+void writeEventLog(const std::string &path, const TraceRecorder &recorder,
+                   std::span<const unsigned int> pids);
+EventLog readEventLog(const std::string &path);
+
+// Columnar result layout (native byte order): ResultColumnsHeader, then
+// `rowCount` values of each column in turn: pid, startTime, burstTime (all
+// uint32), endTime and waitingTime (int32). Every column is 4-byte aligned, so
+// a mapped file can be read in place.
+struct ResultColumnsHeader {
+  char magic[8]; // "RRCOLS\0\0"
+  uint32_t version;
+  uint32_t columnCount;
+  uint64_t rowCount;
+};
+
+void writeResultColumns(const std::string &path, const ProcessTable &procs);
+std::vector<Process> readResultColumns(const std::string &path);
+
+// Chrome trace event JSON (chrome://tracing, Perfetto). Each slice becomes a
+// complete event named after its PID; arrivals and completions are instant
+// events. Times are simulated units shown as microseconds.
+void writeChromeTrace(std::ostream &out, const TraceRecorder &recorder,
+                      std::span<const unsigned int> pids);
@@ -0,0 +1,209 @@
+#include "executor.hpp"
+#include <stdexcept>
+
+using Clock = std::chrono::steady_clock;
+
+// End of the slice the current worker thread is running
+static thread_local Clock::time_point sliceDeadline;
+
+// Task
+Task::Task(Handle handle) : handle(handle) {}
+
+Task::Task(Task &&other) noexcept : handle(other.handle) {
+  other.handle = nullptr;
+}
+
+Task &Task::operator=(Task &&other) noexcept {
+  if (this != &other) {
+    if (handle) {
+      handle.destroy();
+    }
+    handle = other.handle;
+    other.handle = nullptr;
+  }
+  return *this;
+}
+
+Task::~Task() {
+  if (handle) {
+    handle.destroy();
+  }
+}
+
+Task::Handle Task::release() {
+  Handle released = handle;
+  handle = nullptr;
+  return released;
+}
+
+// YieldAwaiter
+bool YieldAwaiter::await_ready() const noexcept {
+  return Clock::now() < sliceDeadline;
+}
+
+YieldAwaiter yieldPoint() { return {}; }
+
+// RoundRobinExecutor
+RoundRobinExecutor::RoundRobinExecutor(unsigned int workerCount,
+                                       std::chrono::microseconds quantum,
+                                       size_t queueCapacity)
+    : quantum(quantum), epoch(Clock::now()),
+      maxUnfinished(queueCapacity * workerCount) {
+  if (workerCount == 0) {
+    throw std::invalid_argument("Executor needs at least one worker.");
+  }
+  workers.reserve(workerCount);
+  for (unsigned int i = 0; i < workerCount; ++i) {
+    workers.push_back(std::make_unique<Worker>(queueCapacity));
+  }
+  for (size_t i = 0; i < workers.size(); ++i) {
+    workers[i]->thread = std::thread(&RoundRobinExecutor::workerLoop, this, i);
+  }
+}
+
+RoundRobinExecutor::~RoundRobinExecutor() {
+  for (size_t n = unfinished.load(); n != 0; n = unfinished.load()) {
+    unfinished.wait(n);
+  }
+  stopping = true;
+  wakeups.fetch_add(1);
+  wakeups.notify_all();
+  for (auto &worker : workers) {
+    worker->thread.join();
+  }
+}
+
+unsigned int RoundRobinExecutor::toMicros(Clock::time_point time) const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(time - epoch)
+      .count();
+}
+
+bool RoundRobinExecutor::findWork(size_t self, void *&job) {
+  if (workers[self]->queue.try_pop(job)) {
+    return true;
+  }
+  // Take from the other queues, starting with the next worker
+  for (size_t i = 1; i < workers.size(); ++i) {
+    if (workers[(self + i) % workers.size()]->queue.try_pop(job)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void RoundRobinExecutor::enqueue(size_t preferred, void *job) {
+  for (;;) {
+    for (size_t i = 0; i < workers.size(); ++i) {
+      if (workers[(preferred + i) % workers.size()]->queue.try_push(job)) {
+        return;
+      }
+    }
+    std::this_thread::yield();
+  }
+}
+
+void RoundRobinExecutor::finish(size_t self, Task::Handle handle) {
+  const auto &promise = handle.promise();
+  const unsigned int start = toMicros(promise.arrival);
+  const unsigned int end = toMicros(Clock::now());
+  const unsigned int busy =
+      std::chrono::duration_cast<std::chrono::microseconds>(promise.busy)
+          .count();
+
+  Process proc(promise.pid, start, busy);
+  proc.endTime = end;
+  // Rounding to microseconds can make busy exceed the turnaround by one
+  proc.waitingTime = end - start > busy ? end - start - busy : 0;
+  workers[self]->completed.push_back(proc);
+
+  if (promise.error) {
+    std::lock_guard<std::mutex> lock(errorMutex);
+    if (!firstError) {
+      firstError = promise.error;
+    }
+  }
+  handle.destroy();
+
+  // Wakes wait() at zero, and submitters waiting for a slot
+  const size_t before = unfinished.fetch_sub(1);
+  if (before == 1 || before == maxUnfinished) {
+    unfinished.notify_all();
+  }
+}
+
+void RoundRobinExecutor::workerLoop(size_t self) {
+  auto &queue = workers[self]->queue;
+  for (;;) {
+    // Read before looking for work so a submission in between is not missed
+    const unsigned int seen = wakeups.load();
+    void *job = nullptr;
+    if (!findWork(self, job)) {
+      if (stopping) {
+        return;
+      }
+      wakeups.wait(seen);
+      continue;
+    }
+
+    auto handle = Task::Handle::from_address(job);
+    const auto start = Clock::now();
+    sliceDeadline = start + quantum;
+    handle.resume();
+    handle.promise().busy += Clock::now() - start;
+
+    if (handle.done()) {
+      finish(self, handle);
+      continue;
+    }
+    // Back of the queue. A full one holds jobs that are waiting on this
+    // worker, so the job goes to the next queue with room instead. There
+    // always is one, as submit() leaves a slot per unfinished job.
+    if (!queue.try_push(job)) {
+      enqueue((self + 1) % workers.size(), job);
+      wakeups.fetch_add(1);
+      wakeups.notify_one();
+    }
+  }
+}
+
+void RoundRobinExecutor::submit(unsigned int pid, Task task) {
+  auto handle = task.release();
+  handle.promise().pid = pid;
+  handle.promise().arrival = Clock::now();
+
+  // Take a slot for the job before queueing it
+  size_t n = unfinished.load();
+  for (;;) {
+    if (n == maxUnfinished) {
+      unfinished.wait(n);
+      n = unfinished.load();
+    } else if (unfinished.compare_exchange_weak(n, n + 1)) {
+      break;
+    }
+  }
+  enqueue(nextWorker.fetch_add(1) % workers.size(), handle.address());
+  wakeups.fetch_add(1);
+  wakeups.notify_one();
+}
+
+void RoundRobinExecutor::wait() {
+  for (size_t n = unfinished.load(); n != 0; n = unfinished.load()) {
+    unfinished.wait(n);
+  }
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(errorMutex);
+    std::swap(error, firstError);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+std::vector<Process> RoundRobinExecutor::results() const {
+  std::vector<Process> all;
+  for (const auto &worker : workers) {
+    all.insert(all.end(), worker->completed.begin(), worker->completed.end());
+  }
+  return all;
+}
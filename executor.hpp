@@ -0,0 +1,122 @@
+#pragma once
+
+#include "containers.hpp"
+#include "scheduler.hpp"
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Real execution mode: the round-robin policy driving actual C++ work instead
+// of simulated bursts. Jobs are coroutines returning Task that call
+// `co_await yieldPoint()` wherever they can be paused. A yield point only
+// suspends once the job has used up its quantum, so checking often is cheap.
+
+class Task {
+public:
+  struct promise_type {
+    unsigned int pid = 0;
+    std::chrono::steady_clock::time_point arrival;
+    std::chrono::steady_clock::duration busy{}; // Time spent running
+    std::exception_ptr error;
+
+    Task get_return_object() {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    // Jobs start when a worker first picks them up
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    // The worker records the result and destroys the frame
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { error = std::current_exception(); }
+  };
+  using Handle = std::coroutine_handle<promise_type>;
+
+  Task(Task &&other) noexcept;
+  Task &operator=(Task &&other) noexcept;
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+  ~Task();
+
+  // Gives up ownership of the coroutine frame
+  Handle release();
+
+private:
+  Handle handle;
+
+  explicit Task(Handle handle);
+};
+
+// Awaitable returned by yieldPoint(). Suspends the calling job, sending it to
+// the back of its worker's queue, only if the current slice has expired.
+struct YieldAwaiter {
+  bool await_ready() const noexcept;
+  void await_suspend(std::coroutine_handle<>) const noexcept {}
+  void await_resume() const noexcept {}
+};
+
+YieldAwaiter yieldPoint();
+
+// Fixed pool of worker threads time-slicing jobs round-robin. Each worker owns
+// a bounded lock-free queue; submissions are spread across the queues and an
+// idle worker takes jobs from the others, so a single long job never holds up
+// the rest of the pool. No more jobs are unfinished than the queues can hold
+// in total, so a job whose slice ends always has a slot to go back to.
+//
+// Results use the Process fields, in microseconds since the executor was
+// created: startTime is the submission time, burstTime the time the job
+// actually ran, and waitingTime the rest of its turnaround.
+class RoundRobinExecutor {
+private:
+  // `completed` is only written by the worker's own thread. Padded so workers
+  // do not share cache lines.
+  struct alignas(64) Worker {
+    BoundedMpmcQueue<void *> queue;
+    std::vector<Process> completed;
+    std::thread thread;
+
+    explicit Worker(size_t queueCapacity) : queue(queueCapacity) {}
+  };
+
+  std::chrono::steady_clock::duration quantum;
+  std::chrono::steady_clock::time_point epoch;
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::atomic<size_t> nextWorker{0};
+  std::atomic<unsigned int> wakeups{0}; // Bumped whenever there is new work
+  size_t maxUnfinished; // Slots across every queue
+  std::atomic<size_t> unfinished{0};
+  std::atomic<bool> stopping{false};
+  std::mutex errorMutex;
+  std::exception_ptr firstError;
+
+  unsigned int toMicros(std::chrono::steady_clock::time_point time) const;
+  bool findWork(size_t self, void *&job);
+  void enqueue(size_t preferred, void *job);
+  void finish(size_t self, Task::Handle handle);
+  void workerLoop(size_t self);
+
+public:
+  // queueCapacity is per worker and must be a power of two. Throws
+  // std::invalid_argument if workerCount is 0.
+  RoundRobinExecutor(unsigned int workerCount,
+                     std::chrono::microseconds quantum,
+                     size_t queueCapacity = 4096);
+  // Waits for every submitted job, then stops the workers
+  ~RoundRobinExecutor();
+
+  // Queues `task` as process `pid`. Blocks while the unfinished jobs would fill
+  // every queue.
+  void submit(unsigned int pid, Task task);
+
+  // Blocks until every submitted job has finished. Rethrows the first
+  // exception that escaped a job.
+  void wait();
+
+  // Results of the finished jobs, in no particular order. Only call while no
+  // jobs are running, e.g. after wait().
+  std::vector<Process> results() const;
+};
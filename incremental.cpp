@@ -0,0 +1,255 @@
+#include "incremental.hpp"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+struct SliceCounter : NullObserver {
+  size_t slices = 0;
+
+  void onSlice(size_t, unsigned int, unsigned int) { slices++; }
+};
+
+} // namespace
+
+IncrementalRoundRobin::IncrementalRoundRobin(
+    unsigned int quantum, size_t segmentSlices,
+    std::pmr::memory_resource *upstream)
+    : SchedulerBase(upstream), policy{quantum},
+      segmentSlices(std::max<size_t>(segmentSlices, 1)),
+      arrivalOrder(&memory), snapshots(&memory) {
+  if (quantum == 0) {
+    throw std::invalid_argument("Time quantum must be positive.");
+  }
+}
+
+void IncrementalRoundRobin::run() {
+  auto &procs = allProcesses;
+  beginRun();
+  sortByArrival(procs.startTime, arrivalOrder);
+  snapshots.clear();
+
+  RoundRobinCursor cursor{runStart, 0};
+  size_t slices = 0;
+  replay(cursor, {}, 0, snapshots, slices);
+  finishTime = cursor.currentTime;
+  currentTime = finishTime;
+  procs.deriveWaitingTimes();
+  lastUpdate = UpdateStats{};
+}
+
+void IncrementalRoundRobin::updateProcess(unsigned int pid,
+                                          unsigned int startTime,
+                                          unsigned int burstTime) {
+  if (burstTime == 0) {
+    throw std::invalid_argument("Burst time must be positive.");
+  }
+  auto &procs = allProcesses;
+  const size_t idx = getIndex(pid);
+  if (!runStarted || arrivalOrder.size() != procs.size()) {
+    procs.startTime[idx] = startTime;
+    procs.burstTime[idx] = burstTime;
+    procs.remainingTime[idx] = burstTime;
+    if (runStarted) {
+      run(); // Processes were added since the last run
+    }
+    return;
+  }
+
+  // Nothing before the edited process arrives, in the old workload or the
+  // new one, can change
+  const unsigned int earliest = std::min(procs.startTime[idx], startTime);
+  const size_t kept =
+      std::partition_point(snapshots.begin(), snapshots.end(),
+                           [earliest](const Snapshot &snapshot) {
+                             return snapshot.time < earliest;
+                           }) -
+      snapshots.begin();
+
+  const size_t oldPos = arrivalPosition(idx);
+  procs.burstTime[idx] = burstTime;
+  const size_t newPos = moveInArrivalOrder(oldPos, startTime);
+
+  RoundRobinCursor cursor;
+  restore(kept > 0 ? &snapshots[kept - 1] : nullptr, cursor);
+  lastUpdate = UpdateStats{};
+  lastUpdate.resumedAt = cursor.currentTime;
+
+  std::pmr::vector<Snapshot> taken(&memory);
+  const std::span<const Snapshot> reference(snapshots.data() + kept,
+                                            snapshots.size() - kept);
+  const size_t match = replay(cursor, reference, std::max(oldPos, newPos) + 1,
+                              taken, lastUpdate.slicesReplayed);
+  lastUpdate.stoppedAt = cursor.currentTime;
+
+  size_t replaced = reference.size();
+  if (match == noMatch) {
+    finishTime = cursor.currentTime;
+  } else {
+    // The old run's results hold from here on; finish off what is pending
+    lastUpdate.converged = true;
+    replaced = match;
+    auto &remaining = procs.remainingTime;
+    for (const auto queued : readyQueue) {
+      remaining[queued] = 0;
+    }
+    for (size_t pos = cursor.nextArrival; pos < arrivalOrder.size(); ++pos) {
+      remaining[arrivalOrder[pos]] = 0;
+    }
+    readyQueue.clear();
+  }
+
+  const auto first = snapshots.begin() + kept;
+  snapshots.erase(first, first + replaced);
+  snapshots.insert(snapshots.begin() + kept,
+                   std::make_move_iterator(taken.begin()),
+                   std::make_move_iterator(taken.end()));
+  currentTime = finishTime;
+  procs.deriveWaitingTimes();
+}
+
+void IncrementalRoundRobin::reset() {
+  SchedulerBase::reset();
+  arrivalOrder.clear();
+  snapshots.clear();
+  finishTime = 0;
+  lastUpdate = UpdateStats{};
+}
+
+void IncrementalRoundRobin::restore(const Snapshot *snapshot,
+                                    RoundRobinCursor &cursor) {
+  auto &procs = allProcesses;
+  readyQueue.clear();
+  cursor = {runStart, 0};
+  if (snapshot != nullptr) {
+    cursor = {snapshot->time, snapshot->nextArrival};
+    for (size_t i = 0; i < snapshot->queue.size(); i += 2) {
+      const auto idx = snapshot->queue[i];
+      readyQueue.push_back(idx);
+      procs.remainingTime[idx] = snapshot->queue[i + 1];
+    }
+  }
+  // Processes that have not arrived yet; the rest stay finished. End times
+  // are overwritten as processes complete again.
+  for (size_t pos = cursor.nextArrival; pos < arrivalOrder.size(); ++pos) {
+    const auto idx = arrivalOrder[pos];
+    procs.remainingTime[idx] = procs.burstTime[idx];
+  }
+}
+
+bool IncrementalRoundRobin::matches(const Snapshot &snapshot,
+                                    const RoundRobinCursor &cursor,
+                                    size_t arrivedBy) const {
+  // Equal arrival positions only mean the same processes have arrived once
+  // the edited one is among them in both runs
+  if (snapshot.time != cursor.currentTime ||
+      snapshot.nextArrival != cursor.nextArrival ||
+      snapshot.nextArrival < arrivedBy ||
+      snapshot.queue.size() != 2 * readyQueue.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < readyQueue.size(); ++i) {
+    const auto idx = readyQueue[i];
+    if (snapshot.queue[2 * i] != idx ||
+        snapshot.queue[2 * i + 1] != allProcesses.remainingTime[idx]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t IncrementalRoundRobin::replay(RoundRobinCursor &cursor,
+                                     std::span<const Snapshot> reference,
+                                     size_t arrivedBy,
+                                     std::pmr::vector<Snapshot> &taken,
+                                     size_t &slices) {
+  auto &procs = allProcesses;
+  const WorkloadView workload{procs.startTime, procs.burstTime, arrivalOrder};
+  SliceCounter counter;
+  // Time between pauses once past the reference snapshots, re-estimated from
+  // each segment so that it holds about `target` slices
+  unsigned long long step =
+      static_cast<unsigned long long>(policy.timeQuantum) * segmentSlices;
+  size_t next = 0;
+  size_t match = noMatch;
+
+  for (;;) {
+    const unsigned int from = cursor.currentTime;
+    const size_t before = counter.slices;
+    const unsigned int stopTime =
+        next < reference.size()
+            ? reference[next].time
+            : static_cast<unsigned int>(
+                  std::min<unsigned long long>(from + step, UINT_MAX));
+    if (resumeRoundRobin(workload, procs.remainingTime, procs.endTime,
+                         readyQueue, policy, cursor, stopTime, counter)) {
+      break;
+    }
+
+    // Check every old snapshot the run has now passed
+    while (next < reference.size() &&
+           reference[next].time <= cursor.currentTime) {
+      if (matches(reference[next], cursor, arrivedBy)) {
+        match = next;
+        break;
+      }
+      next++;
+    }
+    if (match != noMatch) {
+      break;
+    }
+
+    Snapshot snapshot{cursor.currentTime, cursor.nextArrival,
+                      std::pmr::vector<unsigned int>(&memory)};
+    snapshot.queue.reserve(2 * readyQueue.size());
+    for (const auto idx : readyQueue) {
+      snapshot.queue.push_back(idx);
+      snapshot.queue.push_back(procs.remainingTime[idx]);
+    }
+    taken.push_back(std::move(snapshot));
+
+    // A snapshot costs its queue length to take and to restore, so keep
+    // segments at least a few times longer than that
+    const size_t target = std::max(segmentSlices, 4 * readyQueue.size());
+    const unsigned long long elapsed = cursor.currentTime - from;
+    const size_t ran = std::max<size_t>(counter.slices - before, 1);
+    step = std::clamp<unsigned long long>(elapsed * target / ran, 1, 2 * step);
+  }
+  slices += counter.slices;
+  return match;
+}
+
+size_t IncrementalRoundRobin::arrivalPosition(size_t idx) const {
+  const auto &start = allProcesses.startTime;
+  return std::lower_bound(arrivalOrder.begin(), arrivalOrder.end(), idx,
+                          [&start](size_t a, size_t b) {
+                            return start[a] != start[b] ? start[a] < start[b]
+                                                        : a < b;
+                          }) -
+         arrivalOrder.begin();
+}
+
+size_t IncrementalRoundRobin::moveInArrivalOrder(size_t pos,
+                                                 unsigned int newStart) {
+  auto &start = allProcesses.startTime;
+  const auto before = [&start](size_t a, size_t b) {
+    return start[a] != start[b] ? start[a] < start[b] : a < b;
+  };
+  const auto first = arrivalOrder.begin();
+  const auto last = arrivalOrder.end();
+  const auto current = first + pos;
+  const size_t idx = *current;
+  start[idx] = newStart;
+
+  // Everything but the moved process is still sorted
+  if (current + 1 != last && before(*(current + 1), idx)) {
+    const auto target = std::lower_bound(current + 1, last, idx, before);
+    std::rotate(current, current + 1, target);
+    return target - first - 1;
+  }
+  const auto target = std::lower_bound(first, current, idx, before);
+  std::rotate(target, current, current + 1);
+  return target - first;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "scheduler.hpp"
+#include "simulation.hpp"
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+
+// Round robin that answers "what if this one process were different" without
+// rerunning the whole trace.
+//
+// run() simulates the workload once and keeps small in-memory snapshots of the
+// run along the way: the time, the arrival cursor, and the ready queue with
+// the remaining time of each queued process. Everything else follows from the
+// arrival order: earlier processes have finished, later ones have not started.
+// updateProcess() then replays from the last snapshot taken before the edited
+// process arrives (in the old or the new workload). It stops as soon as the
+// replay reaches the same state as one of the old snapshots, because from
+// there on the old run's results hold. Results always match a full rerun.
+//
+//   IncrementalRoundRobin sim(4);
+//   sim.addProcesses(procs);
+//   sim.run();
+//   sim.updateProcess(42, 1000, 7); // pid 42 now arrives at 1000, bursts 7
+//   sim.getProcess(17).endTime;
+//
+// Snapshots are spaced by work rather than time: at least `segmentSlices`
+// slices apart, and further apart while the queue is long, so storing them
+// never costs more than a small fraction of the run.
+class IncrementalRoundRobin : public SchedulerBase {
+public:
+  // How the last updateProcess() went
+  struct UpdateStats {
+    unsigned int resumedAt = 0;        // Time the replay started from
+    unsigned int stoppedAt = 0;        // Time it converged or finished
+    bool converged = false;            // Stopped early on a matching snapshot
+    size_t slicesReplayed = 0;
+  };
+
+private:
+  struct Snapshot {
+    unsigned int time;
+    size_t nextArrival;
+    // (index, remaining time) of each queued process, front first
+    std::pmr::vector<unsigned int> queue;
+  };
+
+  RuntimeQuantum policy;
+  size_t segmentSlices;
+  std::pmr::vector<size_t> arrivalOrder;
+  std::pmr::vector<Snapshot> snapshots; // Strictly increasing times
+  unsigned int finishTime = 0;          // Time the last slice ended
+  UpdateStats lastUpdate;
+
+  static constexpr size_t noMatch = SIZE_MAX;
+
+  // Puts the run back in the state of `snapshot`, or at its start if null
+  void restore(const Snapshot *snapshot, RoundRobinCursor &cursor);
+  // Whether the paused run is in the state of `snapshot`, with the first
+  // `arrivedBy` processes in arrival order already arrived
+  bool matches(const Snapshot &snapshot, const RoundRobinCursor &cursor,
+               size_t arrivedBy) const;
+  // Runs from `cursor`, appending a snapshot to `taken` at every pause. Pauses
+  // at the times of `reference` first and returns the position of the first
+  // one the run matches, or noMatch once every process has completed.
+  size_t replay(RoundRobinCursor &cursor, std::span<const Snapshot> reference,
+                size_t arrivedBy, std::pmr::vector<Snapshot> &taken,
+                size_t &slices);
+  size_t arrivalPosition(size_t idx) const;
+  // Changes the start time of the process at `pos` in arrival order and moves
+  // it to where it now belongs. Returns its new position.
+  size_t moveInArrivalOrder(size_t pos, unsigned int newStart);
+
+public:
+  explicit IncrementalRoundRobin(
+      unsigned int quantum, size_t segmentSlices = size_t{1} << 12,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+
+  // Simulates the whole workload and takes the snapshots
+  void run();
+  // Changes a process's arrival and burst and brings the results up to date.
+  // Before run() it only edits the workload. Throws std::out_of_range for an
+  // unknown pid and std::invalid_argument for a zero burst.
+  void updateProcess(unsigned int pid, unsigned int startTime,
+                     unsigned int burstTime);
+  // Drops the processes and the snapshots
+  void reset();
+
+  const ProcessTable &getProcesses() const { return allProcesses; }
+  size_t snapshotCount() const { return snapshots.size(); }
+  const UpdateStats &getLastUpdate() const { return lastUpdate; }
+};
@@ -0,0 +1,42 @@
+#include "mapped_file.hpp"
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// FileHandle
+FileHandle::FileHandle(const std::string &path)
+    : fd(::open(path.c_str(), O_RDONLY)) {
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open file: " + path);
+  }
+}
+
+FileHandle::~FileHandle() { ::close(fd); }
+
+// MappedFile
+MappedFile::MappedFile(const std::string &path) {
+  FileHandle file(path);
+  struct stat st;
+  if (::fstat(file.get(), &st) != 0) {
+    throw std::runtime_error("Cannot stat file: " + path);
+  }
+  length = static_cast<size_t>(st.st_size);
+  if (length == 0) {
+    return;
+  }
+
+  data = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file.get(), 0);
+  if (data == MAP_FAILED) {
+    data = nullptr;
+    throw std::runtime_error("Cannot map file: " + path);
+  }
+  ::madvise(data, length, MADV_SEQUENTIAL);
+}
+
+MappedFile::~MappedFile() {
+  if (data != nullptr) {
+    ::munmap(data, length);
+  }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Owns a read-only file descriptor for the duration of a read
+class FileHandle {
+private:
+  int fd;
+
+public:
+  explicit FileHandle(const std::string &path);
+  ~FileHandle();
+  FileHandle(const FileHandle &) = delete;
+  FileHandle &operator=(const FileHandle &) = delete;
+
+  int get() const { return fd; }
+};
+
+// Read-only mapping of a whole file
+class MappedFile {
+private:
+  void *data = nullptr;
+  size_t length = 0;
+
+public:
+  explicit MappedFile(const std::string &path);
+  ~MappedFile();
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *bytes() const { return static_cast<const char *>(data); }
+  size_t size() const { return length; }
+};
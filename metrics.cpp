@@ -0,0 +1,198 @@
+#include "metrics.hpp"
+#include <algorithm>
+#include <cmath>
+
+// LatencyHistogram
+LatencyHistogram::LatencyHistogram()
+    : buckets(subBucketCount + (64 - subBucketBits) * halfCount, 0) {}
+
+uint64_t LatencyHistogram::highestInBucket(size_t bucket) {
+  if (bucket < subBucketCount) {
+    return bucket;
+  }
+  const unsigned int shift = (bucket - subBucketCount) / halfCount + 1;
+  const uint64_t top = (bucket - subBucketCount) % halfCount + halfCount;
+  // Wraps to UINT64_MAX for the very last bucket
+  return ((top + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Batch::commit() {
+  hist.total += total;
+  hist.sum += sum;
+  hist.minValue = std::min(hist.minValue, minValue);
+  hist.maxValue = std::max(hist.maxValue, maxValue);
+  total = 0;
+  sum = 0;
+}
+
+double LatencyHistogram::mean() const {
+  return total == 0 ? 0.0 : static_cast<double>(sum) / total;
+}
+
+uint64_t LatencyHistogram::percentile(double quantile) const {
+  if (total == 0) {
+    return 0;
+  }
+  const double clamped = std::clamp(quantile, 0.0, 1.0);
+  const auto rank =
+      std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped * total)));
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+    seen += buckets[bucket];
+    if (seen >= rank) {
+      return std::min(highestInBucket(bucket), maxValue);
+    }
+  }
+  return maxValue;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+  for (size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+    buckets[bucket] += other.buckets[bucket];
+  }
+  total += other.total;
+  sum += other.sum;
+  minValue = std::min(minValue, other.minValue);
+  maxValue = std::max(maxValue, other.maxValue);
+}
+
+void LatencyHistogram::reset() {
+  std::fill(buckets.begin(), buckets.end(), 0);
+  total = 0;
+  sum = 0;
+  minValue = UINT64_MAX;
+  maxValue = 0;
+}
+
+// SchedulerMetrics
+void SchedulerMetrics::reset() {
+  waitingTime.reset();
+  turnaroundTime.reset();
+  sliceLength.reset();
+  slices = 0;
+  contextSwitches = 0;
+  idleTime = 0;
+  queueHighWater = 0;
+  runSeconds = 0.0;
+}
+
+// MetricsObserver
+void MetricsObserver::flush() {
+  LatencyHistogram::Batch turnaroundTimes(metrics.turnaroundTime);
+  LatencyHistogram::Batch waitingTimes(metrics.waitingTime);
+  LatencyHistogram::Batch partialSlices(metrics.sliceLength);
+  uint64_t fullSlices = 0;
+  uint64_t slices = 0;
+  for (size_t idx = 0; idx < endTime.size(); ++idx) {
+    if (endTime[idx] < 0) {
+      continue;
+    }
+    const unsigned int burst = workload.burstTime[idx];
+    const unsigned int turnaround = endTime[idx] - workload.startTime[idx];
+    turnaroundTimes.record(turnaround);
+    waitingTimes.record(turnaround - burst);
+
+    fullSlices += burst / timeQuantum;
+    if (burst % timeQuantum != 0) {
+      partialSlices.record(burst % timeQuantum);
+      slices++;
+    }
+  }
+  turnaroundTimes.commit();
+  waitingTimes.commit();
+  partialSlices.commit();
+  if (fullSlices > 0) {
+    metrics.sliceLength.record(timeQuantum, fullSlices);
+  }
+  slices += fullSlices;
+
+  metrics.slices += slices;
+  // Every slice after the first either switched process or repeated one
+  if (slices > 0) {
+    metrics.contextSwitches += slices - 1 - (repeatsCarry + repeats);
+  }
+  metrics.queueHighWater =
+      std::max<size_t>(metrics.queueHighWater, queueHighWater);
+}
+
+// Exports
+namespace {
+
+struct NamedHistogram {
+  const char *name;
+  const char *help;
+  const LatencyHistogram &histogram;
+};
+
+struct Quantile {
+  const char *label;   // Prometheus quantile label
+  const char *jsonKey;
+  double value;
+};
+
+constexpr Quantile quantiles[] = {{"0.5", "p50", 0.5},
+                                  {"0.9", "p90", 0.9},
+                                  {"0.99", "p99", 0.99},
+                                  {"0.999", "p999", 0.999}};
+
+std::vector<NamedHistogram> histogramsOf(const SchedulerMetrics &metrics) {
+  return {{"waiting_time", "Time each process spent in the ready queue",
+           metrics.waitingTime},
+          {"turnaround_time", "Time from arrival to completion",
+           metrics.turnaroundTime},
+          {"slice_length", "Length of each time slice", metrics.sliceLength}};
+}
+
+} // namespace
+
+void writeMetricsJson(std::ostream &out, const SchedulerMetrics &metrics) {
+  out << "{\n";
+  for (const auto &named : histogramsOf(metrics)) {
+    const auto &hist = named.histogram;
+    out << "  \"" << named.name << "\": {\"count\": " << hist.count()
+        << ", \"sum\": " << hist.getSum() << ", \"min\": " << hist.min()
+        << ", \"max\": " << hist.max() << ", \"mean\": " << hist.mean();
+    for (const auto &q : quantiles) {
+      out << ", \"" << q.jsonKey << "\": " << hist.percentile(q.value);
+    }
+    out << "},\n";
+  }
+  out << "  \"slices\": " << metrics.slices << ",\n"
+      << "  \"context_switches\": " << metrics.contextSwitches << ",\n"
+      << "  \"idle_time\": " << metrics.idleTime << ",\n"
+      << "  \"queue_high_water\": " << metrics.queueHighWater << ",\n"
+      << "  \"run_seconds\": " << metrics.runSeconds << "\n"
+      << "}\n";
+}
+
+void writeMetricsPrometheus(std::ostream &out, const SchedulerMetrics &metrics,
+                            std::string_view prefix) {
+  for (const auto &named : histogramsOf(metrics)) {
+    const auto &hist = named.histogram;
+    out << "# HELP " << prefix << '_' << named.name << ' ' << named.help
+        << "\n# TYPE " << prefix << '_' << named.name << " summary\n";
+    for (const auto &q : quantiles) {
+      out << prefix << '_' << named.name << "{quantile=\"" << q.label
+          << "\"} " << hist.percentile(q.value) << '\n';
+    }
+    out << prefix << '_' << named.name << "_sum " << hist.getSum() << '\n'
+        << prefix << '_' << named.name << "_count " << hist.count() << '\n';
+  }
+
+  auto scalar = [&](const char *name, const char *type, const char *help,
+                    auto value) {
+    out << "# HELP " << prefix << '_' << name << ' ' << help << "\n# TYPE "
+        << prefix << '_' << name << ' ' << type << '\n'
+        << prefix << '_' << name << ' ' << value << '\n';
+  };
+  scalar("slices_total", "counter", "Time slices executed", metrics.slices);
+  scalar("context_switches_total", "counter",
+         "Slices that ran a different process than the one before",
+         metrics.contextSwitches);
+  scalar("idle_time_total", "counter", "Time with no process ready",
+         metrics.idleTime);
+  scalar("queue_high_water", "gauge", "Longest ready queue seen",
+         metrics.queueHighWater);
+  scalar("run_seconds", "gauge", "Wall-clock duration of the last run",
+         metrics.runSeconds);
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "simulation.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Metrics are collected unless the build defines SCHEDULER_ENABLE_METRICS=0
+// (CMake option SCHEDULER_METRICS). When disabled the scheduling loop gets a
+// NullObserver and every hook compiles away.
+#ifndef SCHEDULER_ENABLE_METRICS
+#define SCHEDULER_ENABLE_METRICS 1
+#endif
+inline constexpr bool metricsEnabled = SCHEDULER_ENABLE_METRICS != 0;
+
+// Log-linear histogram in the style of HdrHistogram. Values below 128 get a
+// bucket each; above that every power of two is split into 64 buckets, so any
+// reported value is within 1/64 of the recorded one. Recording is a shift, a
+// bit_width and an increment.
+class LatencyHistogram {
+private:
+  static constexpr unsigned int subBucketBits = 7;
+  static constexpr uint64_t subBucketCount = uint64_t{1} << subBucketBits;
+  static constexpr uint64_t halfCount = subBucketCount / 2;
+
+  std::vector<uint64_t> buckets;
+  uint64_t total = 0;
+  uint64_t sum = 0;
+  uint64_t minValue = UINT64_MAX;
+  uint64_t maxValue = 0;
+
+  static size_t bucketFor(uint64_t value) {
+    if (value < subBucketCount) {
+      return value;
+    }
+    const unsigned int shift = std::bit_width(value) - subBucketBits;
+    return subBucketCount + (shift - 1) * halfCount +
+           ((value >> shift) - halfCount);
+  }
+  // Largest value that falls into `bucket`
+  static uint64_t highestInBucket(size_t bucket);
+
+public:
+  LatencyHistogram();
+
+  void record(uint64_t value, uint64_t times = 1) {
+    buckets[bucketFor(value)] += times;
+    total += times;
+    sum += value * times;
+    minValue = value < minValue ? value : minValue;
+    maxValue = value > maxValue ? value : maxValue;
+  }
+
+  // Records many values in a tight loop. The running totals live in the
+  // Batch, so they stay in registers instead of being reloaded after every
+  // bucket store. Nothing is visible in the histogram until commit().
+  class Batch {
+  private:
+    LatencyHistogram &hist;
+    uint64_t *buckets;
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    uint64_t minValue = UINT64_MAX;
+    uint64_t maxValue = 0;
+
+  public:
+    explicit Batch(LatencyHistogram &hist)
+        : hist(hist), buckets(hist.buckets.data()) {}
+
+    void record(uint64_t value) {
+      buckets[bucketFor(value)]++;
+      total++;
+      sum += value;
+      minValue = value < minValue ? value : minValue;
+      maxValue = value > maxValue ? value : maxValue;
+    }
+
+    void commit();
+  };
+
+  uint64_t count() const { return total; }
+  uint64_t getSum() const { return sum; }
+  uint64_t min() const { return total == 0 ? 0 : minValue; }
+  uint64_t max() const { return maxValue; }
+  double mean() const;
+  // Smallest bucket bound with at least `quantile` of the values at or below
+  // it; quantile is in [0, 1]
+  uint64_t percentile(double quantile) const;
+
+  void merge(const LatencyHistogram &other);
+  // Keeps the bucket array so collecting again does not allocate
+  void reset();
+};
+
+struct SchedulerMetrics {
+  LatencyHistogram waitingTime;
+  LatencyHistogram turnaroundTime;
+  LatencyHistogram sliceLength; // Simulated time units per slice
+  uint64_t slices = 0;
+  uint64_t contextSwitches = 0; // Consecutive slices of different processes
+  uint64_t idleTime = 0;        // Time with nothing ready to run
+  size_t queueHighWater = 0;    // Longest the ready queue got
+  double runSeconds = 0.0;      // Wall-clock time of the last run
+
+  void reset();
+};
+
+// Round-robin hooks that fill a SchedulerMetrics. The loop only updates a
+// few 32-bit fields: wider stores could alias the ring buffer's size_t fields
+// and force the loop to reload them after every slice. Everything that follows
+// from the finished schedule is computed by flush(), which must be called once
+// the loop has returned: waiting and turnaround times come from endTime, and
+// slice lengths from the burst and quantum (each process runs burst / quantum
+// full slices plus one for the remainder).
+class MetricsObserver {
+private:
+  SchedulerMetrics &metrics;
+  WorkloadView workload;
+  std::span<const int> endTime;
+  unsigned int timeQuantum;
+  uint32_t lastIdx = UINT32_MAX;
+  uint32_t repeats = 0;      // Slices that continued the previous process
+  uint64_t repeatsCarry = 0; // Whole wraps of `repeats`
+  uint32_t queueHighWater = 0;
+
+public:
+  MetricsObserver(SchedulerMetrics &metrics, const WorkloadView &workload,
+                  std::span<const int> endTime, unsigned int timeQuantum)
+      : metrics(metrics), workload(workload), endTime(endTime),
+        timeQuantum(timeQuantum) {}
+
+  void onArrival(size_t, unsigned int) {}
+
+  void onIdle(unsigned int from, unsigned int to) {
+    metrics.idleTime += to - from;
+  }
+
+  void onSlice(size_t idx, unsigned int, unsigned int) {
+    if (idx == lastIdx && ++repeats == 0) {
+      repeatsCarry += uint64_t{1} << 32;
+    }
+    lastIdx = idx;
+  }
+
+  void onQueueLength(size_t length) {
+    queueHighWater = length > queueHighWater ? length : queueHighWater;
+  }
+
+  void onPreempt(size_t, unsigned int) {}
+  void onComplete(size_t, unsigned int) {}
+
+  void flush();
+};
+
+// Machine-readable exports. Histograms are reported as count, sum, min, max,
+// mean and the 50th, 90th, 99th and 99.9th percentiles.
+void writeMetricsJson(std::ostream &out, const SchedulerMetrics &metrics);
+void writeMetricsPrometheus(std::ostream &out, const SchedulerMetrics &metrics,
+                            std::string_view prefix = "scheduler");
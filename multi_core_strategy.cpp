@@ -0,0 +1,260 @@
+#include "multi_core_strategy.hpp"
+#include "simulation.hpp"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+struct Core {
+  RingBuffer<unsigned int> queue;
+  int running = -1; // Index of the process on the CPU, -1 when idle
+
+  explicit Core(std::pmr::memory_resource *resource) : queue(resource) {}
+};
+
+// Set of idle cores with O(1) insert and erase
+class IdleSet {
+private:
+  std::pmr::vector<unsigned int> cores;
+  std::pmr::vector<size_t> position;
+
+public:
+  IdleSet(unsigned int numCores, std::pmr::memory_resource *resource)
+      : cores(resource), position(numCores, resource) {
+    cores.reserve(numCores);
+    for (unsigned int c = 0; c < numCores; ++c) {
+      position[c] = cores.size();
+      cores.push_back(c);
+    }
+  }
+
+  bool empty() const { return cores.empty(); }
+  unsigned int back() const { return cores.back(); }
+
+  void insert(unsigned int core) {
+    position[core] = cores.size();
+    cores.push_back(core);
+  }
+
+  void erase(unsigned int core) {
+    const auto last = cores.back();
+    cores[position[core]] = last;
+    position[last] = position[core];
+    cores.pop_back();
+  }
+};
+
+// The cores sorted by a per-core count that only ever moves by one, so a
+// change is a swap to the edge of its bucket of equal counts: O(1) to update
+// and to find the lowest or highest count.
+class CoreCounts {
+private:
+  std::pmr::vector<unsigned int> order; // Ascending by count
+  std::pmr::vector<size_t> position;    // In `order`, by core
+  std::pmr::vector<size_t> count;       // By core
+  std::pmr::vector<size_t> bucketStart; // First position with at least k
+
+  void swapPositions(size_t a, size_t b) {
+    std::swap(order[a], order[b]);
+    position[order[a]] = a;
+    position[order[b]] = b;
+  }
+
+public:
+  // Every count starts at 0
+  CoreCounts(unsigned int numCores, std::pmr::memory_resource *resource)
+      : order(numCores, resource), position(numCores, resource),
+        count(numCores, 0, resource), bucketStart(resource) {
+    for (unsigned int c = 0; c < numCores; ++c) {
+      order[c] = c;
+      position[c] = c;
+    }
+    bucketStart.assign({0, numCores});
+  }
+
+  unsigned int lowest() const { return order.front(); }
+  unsigned int highest() const { return order.back(); }
+
+  void increment(unsigned int core) {
+    const size_t k = count[core]++;
+    if (k + 2 == bucketStart.size()) {
+      bucketStart.push_back(order.size());
+    }
+    // Last of the cores at k becomes the first at k + 1
+    swapPositions(position[core], --bucketStart[k + 1]);
+  }
+
+  void decrement(unsigned int core) {
+    const size_t k = count[core]--;
+    swapPositions(position[core], bucketStart[k]++);
+  }
+};
+
+} // namespace
+
+MultiCoreRoundRobinStrategy::MultiCoreRoundRobinStrategy(
+    unsigned int cores, unsigned int quantum, PlacementPolicy policy,
+    bool stealing)
+    : numCores(cores), timeQuantum(quantum), placement(policy),
+      workStealing(stealing) {
+  if (numCores == 0) {
+    throw std::invalid_argument("Need at least one core.");
+  }
+}
+
+const std::vector<CoreStats> &
+MultiCoreRoundRobinStrategy::getCoreStats() const {
+  return coreStats;
+}
+
+void MultiCoreRoundRobinStrategy::run(Scheduler &scheduler) {
+  auto &procs = scheduler.getProcesses();
+  const auto &startTime = procs.startTime;
+  auto &remainingTime = procs.remainingTime;
+
+  auto *resource = scheduler.getResource();
+  auto &sortedIndices = scheduler.getProgress().arrivalOrder;
+  sortByArrival(startTime, sortedIndices);
+
+  std::pmr::vector<Core> cores(resource);
+  cores.reserve(numCores);
+  for (unsigned int c = 0; c < numCores; ++c) {
+    cores.emplace_back(resource).queue.reserve(
+        std::max<size_t>(16, procs.size() / numCores));
+  }
+  coreStats.assign(numCores, CoreStats{});
+  IdleSet idle(numCores, resource);
+  // Processes on each core, running or queued. A preempted process counts
+  // while it waits to be queued again, so the load only changes when a
+  // process arrives, completes or is stolen, not on every slice. Between events a
+  // core with a queue is never idle, so it has a load of at least 2 and the
+  // most loaded core also has the longest queue.
+  const bool trackLoad =
+      placement == PlacementPolicy::LeastLoaded || workStealing;
+  CoreCounts load(trackLoad ? numCores : 0, resource);
+
+  // Slice-end events ordered by (time, core)
+  using Event = std::pair<unsigned long long, unsigned int>;
+  std::pmr::vector<Event> eventStorage(resource);
+  eventStorage.reserve(numCores);
+  std::priority_queue<Event, std::pmr::vector<Event>, std::greater<Event>>
+      events(std::greater<Event>(), std::move(eventStorage));
+
+  // Cores that changed this event, and the (core, idx) pairs preempted by it
+  std::pmr::vector<unsigned int> touched(resource);
+  std::pmr::vector<std::pair<unsigned int, unsigned int>> preempted(resource);
+  touched.reserve(numCores);
+  preempted.reserve(numCores);
+
+  size_t nextToPush = 0;
+  size_t queued = 0; // Processes waiting across all core queues
+  unsigned int nextCore = 0;
+  const unsigned long long runStart = scheduler.getCurrentTime();
+  unsigned long long time = runStart;
+
+  auto chooseCore = [&]() -> unsigned int {
+    if (placement == PlacementPolicy::RoundRobin) {
+      const auto core = nextCore;
+      nextCore = (nextCore + 1) % numCores;
+      return core;
+    }
+    return load.lowest();
+  };
+
+  auto dispatch = [&](unsigned int c, unsigned int idx) {
+    const unsigned int runningTime = std::min(timeQuantum, remainingTime[idx]);
+    remainingTime[idx] -= runningTime;
+    cores[c].running = idx;
+    coreStats[c].busyTime += runningTime;
+    coreStats[c].slices++;
+    idle.erase(c);
+    events.emplace(time + runningTime, c);
+  };
+
+  // Takes the oldest process off core `from`'s queue and runs it on `to`
+  auto dispatchFromQueue = [&](unsigned int from, unsigned int to) {
+    const auto idx = cores[from].queue.front();
+    cores[from].queue.pop_front();
+    queued--;
+    if (trackLoad && from != to) {
+      load.decrement(from);
+      load.increment(to);
+    }
+    dispatch(to, idx);
+  };
+
+  while (!events.empty() || nextToPush < sortedIndices.size()) {
+    // Jump to the next slice end or arrival, whichever comes first. Processes
+    // that arrived before the run started are all queued at its start.
+    unsigned long long next = events.empty()
+                                  ? startTime[sortedIndices[nextToPush]]
+                                  : events.top().first;
+    if (nextToPush < sortedIndices.size()) {
+      next = std::min<unsigned long long>(next,
+                                          startTime[sortedIndices[nextToPush]]);
+    }
+    time = std::max(time, next);
+
+    // Slices ending now free their core
+    while (!events.empty() && events.top().first == time) {
+      const auto c = events.top().second;
+      events.pop();
+      const auto idx = static_cast<unsigned int>(cores[c].running);
+      cores[c].running = -1;
+      idle.insert(c);
+      touched.push_back(c);
+      if (remainingTime[idx] > 0) {
+        preempted.emplace_back(c, idx);
+      } else {
+        scheduler.markProcComplete(idx, time);
+        if (trackLoad) {
+          load.decrement(c);
+        }
+      }
+    }
+
+    // As on a single core, arrivals are queued before preempted processes
+    while (nextToPush < sortedIndices.size() &&
+           startTime[sortedIndices[nextToPush]] <= time) {
+      const auto c = chooseCore();
+      cores[c].queue.push_back(sortedIndices[nextToPush]);
+      queued++;
+      if (trackLoad) {
+        load.increment(c);
+      }
+      touched.push_back(c);
+      nextToPush++;
+    }
+    for (const auto &[c, idx] : preempted) {
+      cores[c].queue.push_back(idx);
+      queued++;
+    }
+    preempted.clear();
+
+    // Idle cores only ever have empty queues between events, so only cores
+    // that just freed up or received work can start a slice from their queue
+    for (const auto c : touched) {
+      if (cores[c].running < 0 && !cores[c].queue.empty()) {
+        dispatchFromQueue(c, c);
+      }
+    }
+    touched.clear();
+
+    // Cores that are still idle steal from the longest queue
+    while (workStealing && queued > 0 && !idle.empty()) {
+      const auto thief = idle.back();
+      coreStats[thief].steals++;
+      dispatchFromQueue(load.highest(), thief);
+    }
+  }
+
+  scheduler.setCurrentTime(static_cast<unsigned int>(time));
+  const unsigned long long span = time - runStart;
+  for (auto &stats : coreStats) {
+    stats.utilization =
+        span == 0 ? 0.0 : static_cast<double>(stats.busyTime) / span;
+  }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "containers.hpp"
+#include "scheduler.hpp"
+#include <vector>
+
+// How newly arrived processes are assigned to a core
+enum class PlacementPolicy {
+  RoundRobin,  // Cycle through the cores
+  LeastLoaded, // Core with the fewest running and queued processes
+};
+
+struct CoreStats {
+  unsigned long long busyTime = 0;
+  size_t slices = 0;
+  size_t steals = 0; // Processes taken from another core's queue
+  double utilization = 0.0; // busyTime / (end - start of the run)
+};
+
+// Round-robin over N simulated cores, each with its own ready queue. A core
+// whose queue runs dry steals the oldest waiting process from the longest
+// queue. The simulation is event driven: it jumps between slice ends and
+// arrivals, so its cost grows with the number of events, not with time.
+class MultiCoreRoundRobinStrategy : public SchedulerStrategy {
+private:
+  unsigned int numCores;
+  unsigned int timeQuantum;
+  PlacementPolicy placement;
+  bool workStealing;
+  std::vector<CoreStats> coreStats;
+
+public:
+  MultiCoreRoundRobinStrategy(unsigned int cores, unsigned int quantum,
+                              PlacementPolicy policy = PlacementPolicy::LeastLoaded,
+                              bool stealing = true);
+  void run(Scheduler &scheduler) override;
+
+  // Per-core statistics of the last run
+  const std::vector<CoreStats> &getCoreStats() const;
+};
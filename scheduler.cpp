@@ -1,43 +1,102 @@
 #include "scheduler.hpp"
+#include "event_trace.hpp"
+#include "simulation.hpp"
 #include <algorithm>
+#include <chrono>
+#include <climits>
 #include <iomanip>
 #include <iostream>
-#include <numeric>
+#include <stdexcept>
 
 // Process
 Process::Process(unsigned int pid, unsigned int startTime,
                  unsigned int burstTime)
     : pid(pid), startTime(startTime), burstTime(burstTime) {}
 
-// Scheduler
-Scheduler::Scheduler(SchedulerStrategy *strat)
-    : currentTime(0), strategy(strat) {}
+// ProcessTable
+ProcessTable::ProcessTable(std::pmr::memory_resource *resource)
+    : startTime(resource), remainingTime(resource), pid(resource),
+      burstTime(resource), waitingTime(resource), endTime(resource) {}
 
-Scheduler::~Scheduler() { delete strategy; }
+size_t ProcessTable::size() const { return pid.size(); }
 
-void Scheduler::setCurrentTime(const unsigned int newTime) {
-  currentTime = newTime;
+size_t ProcessTable::capacity() const { return pid.capacity(); }
+
+bool ProcessTable::empty() const { return pid.empty(); }
+
+void ProcessTable::reserve(size_t n) {
+  startTime.reserve(n);
+  remainingTime.reserve(n);
+  pid.reserve(n);
+  burstTime.reserve(n);
+  waitingTime.reserve(n);
+  endTime.reserve(n);
+}
+
+void ProcessTable::push_back(const Process &proc) {
+  startTime.push_back(proc.startTime);
+  remainingTime.push_back(proc.burstTime);
+  pid.push_back(proc.pid);
+  burstTime.push_back(proc.burstTime);
+  waitingTime.push_back(proc.waitingTime);
+  endTime.push_back(proc.endTime);
 }
 
-void Scheduler::updateWaitingTimes(const Process &currentProcess,
-                                   const size_t runningTime) {
-  for (auto pid : readyQueue) {
-    auto &proc = allProcesses[pidToVecIndex[pid]];
+void ProcessTable::clear() {
+  startTime.clear();
+  remainingTime.clear();
+  pid.clear();
+  burstTime.clear();
+  waitingTime.clear();
+  endTime.clear();
+}
+
+void ProcessTable::rewind() {
+  std::copy(burstTime.begin(), burstTime.end(), remainingTime.begin());
+  std::fill(waitingTime.begin(), waitingTime.end(), 0);
+  std::fill(endTime.begin(), endTime.end(), -1);
+}
 
-    // Do NOT update waiting time for part of process added at back of queue
-    if (currentProcess.pid != proc.pid) {
-      proc.waitingTime += runningTime;
+void ProcessTable::deriveWaitingTimes() {
+  for (size_t idx = 0; idx < size(); ++idx) {
+    if (endTime[idx] >= 0) {
+      waitingTime[idx] = endTime[idx] - startTime[idx] - burstTime[idx];
     }
   }
 }
 
-Process &Scheduler::getProcess(const unsigned int pid) {
-  auto it = pidToVecIndex.find(pid);
-  if (it != pidToVecIndex.end()) {
-    size_t idx = it->second;
-    if (idx < allProcesses.size()) {
-      if (allProcesses[idx].pid == pid) {
-        return allProcesses[idx];
+Process ProcessTable::operator[](size_t idx) const {
+  Process proc(pid[idx], startTime[idx], burstTime[idx]);
+  proc.waitingTime = waitingTime[idx];
+  proc.endTime = endTime[idx];
+  return proc;
+}
+
+// RunProgress
+void RunProgress::clear() {
+  arrivalOrder.clear();
+  nextArrival = 0;
+  active = false;
+}
+
+// SchedulerBase
+SchedulerBase::SchedulerBase(std::pmr::memory_resource *upstream)
+    : memory(upstream), currentTime(0), readyQueue(&memory),
+      allProcesses(&memory), pidToVecIndex(&memory),
+      progress{std::pmr::vector<size_t>(&memory)} {}
+
+void SchedulerBase::setCurrentTime(const unsigned int newTime) {
+  currentTime = newTime;
+}
+
+unsigned int SchedulerBase::getCurrentTime() const { return currentTime; }
+
+size_t SchedulerBase::getIndex(const unsigned int pid) const {
+  const int *idx = pidToVecIndex.find(pid);
+  if (idx != nullptr) {
+    if (static_cast<size_t>(*idx) < allProcesses.size()) {
+      if (allProcesses.pid[*idx] == pid) {
+        return *idx;
       } else {
         throw std::out_of_range("PID mapping mismatch.");
       }
@@ -49,91 +108,175 @@ Process &Scheduler::getProcess(const unsigned int pid) {
   }
 }
 
-size_t Scheduler::processTimeSlice(Process &currentProcess,
-                                   const unsigned int timeQuantum, const std::vector<size_t> &sortedIndices,
-                                   size_t& nextToPush) {
-  size_t runningTime = 0;
-
-  for (size_t dt = 1; dt <= timeQuantum && currentProcess.burstTime > 0; ++dt) {
-    currentProcess.burstTime--;
-    runningTime++;
-    currentTime++;
-
-    // Need to check whether process arrives during current process in on CPU
-    while (nextToPush < sortedIndices.size() &&
-           allProcesses[sortedIndices[nextToPush]].startTime <= currentTime) {
-      readyQueue.push_back(allProcesses[sortedIndices[nextToPush]].pid);
-      nextToPush++;
-    }
+void SchedulerBase::checkNotPaused() const {
+  // A paused run's arrival order covers only the processes it started with,
+  // so a process added now would never run
+  if (progress.paused()) {
+    throw std::runtime_error("Cannot add processes while a run is paused.");
   }
-
-  return runningTime;
-}
-
-void Scheduler::markProcComplete(const unsigned int idx,
-                                 const unsigned int currentTime) {
-  allProcesses[idx].endTime = currentTime;
 }
 
-std::deque<unsigned int> &Scheduler::getQueue() { return readyQueue; }
-
-std::vector<Process> &Scheduler::getProcesses() { return allProcesses; }
-
-std::unordered_map<unsigned int, int> &Scheduler::getPIDToVecIndex() {
-  return pidToVecIndex;
+Process SchedulerBase::getProcess(const unsigned int pid) const {
+  return allProcesses[getIndex(pid)];
 }
 
-unsigned int Scheduler::getCurrentTime() { return currentTime; }
-
-void Scheduler::addProcess(Process proc) {
+void SchedulerBase::addProcess(Process proc) {
+  checkNotPaused();
   if (proc.burstTime > 0) {
-    const auto pid = proc.pid;
-    allProcesses.push_back(std::move(proc));
-    pidToVecIndex[pid] = allProcesses.size() - 1;
-    std::cout << "Added process with pid " << pid << std::endl;
+    allProcesses.push_back(proc);
+    pidToVecIndex.insert_or_assign(proc.pid, allProcesses.size() - 1);
+    std::cout << "Added process with pid " << proc.pid << "\n";
   } else {
     std::cout << "Ignored process with burstTime 0 (pid = " << proc.pid
               << ")\n";
   }
 }
 
-void Scheduler::run() { strategy->run(*this); }
+void SchedulerBase::addProcesses(std::span<const Process> procs) {
+  checkNotPaused();
+  // Grow geometrically so loaders feeding many small batches stay linear
+  const size_t needed = allProcesses.size() + procs.size();
+  if (needed > allProcesses.capacity()) {
+    reserve(std::max(needed, allProcesses.capacity() * 2));
+  }
+
+  // Same rules as addProcess, without logging every process
+  for (const auto &proc : procs) {
+    if (proc.burstTime > 0) {
+      allProcesses.push_back(proc);
+      pidToVecIndex.insert_or_assign(proc.pid, allProcesses.size() - 1);
+    }
+  }
+}
 
-void Scheduler::printProcess(const unsigned int pid) {
-  const auto i_proc = pidToVecIndex[pid];
-  const auto &proc = allProcesses[i_proc];
+void SchedulerBase::reserve(size_t n) {
+  allProcesses.reserve(n);
+  pidToVecIndex.reserve(n);
+}
+
+static void printProcessRow(const Process &proc) {
   std::cout << std::setw(12) << proc.pid << std::setw(12) << proc.startTime
             << std::setw(12) << proc.endTime << std::setw(12) << proc.burstTime
             << std::setw(12) << proc.waitingTime << "\n";
 }
 
-void Scheduler::printQueue() {
+void SchedulerBase::printProcess(const unsigned int pid) {
+  printProcessRow(getProcess(pid));
+}
+
+void SchedulerBase::printQueue() {
   std::cout
       << "      ==========================Process========================\n";
   std::cout << std::setw(12) << "PID" << std::setw(12) << "Start"
             << std::setw(12) << "End" << std::setw(12) << "Burst"
             << std::setw(12) << "Waiting\n";
-  for (const auto pid : readyQueue) {
-    printProcess(pid);
+  for (const auto idx : readyQueue) {
+    printProcessRow(allProcesses[idx]);
   }
 }
 
-void Scheduler::printProcessesMetaData() {
+void SchedulerBase::printProcessesMetaData() {
   std::cout
       << "      ==========================Process========================\n";
   std::cout << std::setw(12) << "PID" << std::setw(12) << "Start"
             << std::setw(12) << "End" << std::setw(12) << "Burst"
             << std::setw(12) << "Waiting\n";
-  for (const auto &proc : allProcesses) {
-    printProcess(proc.pid);
+  for (size_t idx = 0; idx < allProcesses.size(); ++idx) {
+    printProcessRow(allProcesses[idx]);
   }
 }
 
-void Scheduler::reset() {
+void SchedulerBase::reset() {
   allProcesses.clear();
   readyQueue.clear();
   pidToVecIndex.clear();
+  progress.clear();
   currentTime = 0;
+  runStart = 0;
+  runStarted = false;
+}
+
+void SchedulerBase::beginRun() {
+  if (!runStarted) {
+    runStarted = true;
+    runStart = currentTime;
+    return;
+  }
+  allProcesses.rewind();
+  readyQueue.clear();
+  currentTime = runStart;
+}
+
+std::pmr::memory_resource *SchedulerBase::getResource() { return &memory; }
+
+size_t SchedulerBase::getAllocationCount() const {
+  return memory.allocationCount();
+}
+
+size_t SchedulerBase::getLastRunAllocations() const {
+  return lastRunAllocations;
+}
+
+// Scheduler
+Scheduler::Scheduler(SchedulerStrategy *strat,
+                     std::pmr::memory_resource *upstream)
+    : SchedulerBase(upstream), strategy(strat), ownsStrategy(true) {}
+
+Scheduler::Scheduler(SchedulerStrategy &strat,
+                     std::pmr::memory_resource *upstream)
+    : SchedulerBase(upstream), strategy(&strat), ownsStrategy(false) {}
+
+Scheduler::~Scheduler() {
+  if (ownsStrategy) {
+    delete strategy;
+  }
+}
+
+void Scheduler::markProcComplete(const size_t idx,
+                                 const unsigned int currentTime) {
+  allProcesses.endTime[idx] = currentTime;
+
+  // A process is either running or waiting between arrival and completion, so
+  // waiting time falls out of the turnaround time without per-slice updates
+  allProcesses.waitingTime[idx] =
+      currentTime - allProcesses.startTime[idx] - allProcesses.burstTime[idx];
+}
+
+RingBuffer<unsigned int> &Scheduler::getQueue() { return readyQueue; }
+
+ProcessTable &Scheduler::getProcesses() { return allProcesses; }
+
+FlatPidMap &Scheduler::getPIDToVecIndex() { return pidToVecIndex; }
+
+RunProgress &Scheduler::getProgress() { return progress; }
+
+void Scheduler::run() {
+  const size_t before = memory.allocationCount();
+  if (!progress.paused()) {
+    beginRun();
+  }
+  // Size the queue up front so the strategy never allocates
+  readyQueue.reserve(allProcesses.size());
+  strategy->run(*this);
+  lastRunAllocations = memory.allocationCount() - before;
+}
+
+// Runs `kernel` over the scheduler's processes in arrival order and fills in
+// the per-process results. kernel(workload, remainingTime, endTime, time)
+// returns the time the last slice ended.
+template <typename Kernel>
+static void runKernel(Scheduler &scheduler, Kernel &&kernel) {
+  auto &procs = scheduler.getProcesses();
+
+  // Processes are queued in order of startTime; ties keep insertion order
+  auto &sortedIndices = scheduler.getProgress().arrivalOrder;
+  sortByArrival(procs.startTime, sortedIndices);
+  const WorkloadView workload{procs.startTime, procs.burstTime, sortedIndices};
+
+  scheduler.setCurrentTime(kernel(workload, procs.remainingTime, procs.endTime,
+                                  scheduler.getCurrentTime()));
+
+  procs.deriveWaitingTimes();
 }
 
 // RoundRobinStrategy
@@ -141,64 +284,146 @@ RoundRobinStrategy::RoundRobinStrategy(unsigned int quantum)
     : timeQuantum(quantum) {}
 
 void RoundRobinStrategy::run(Scheduler &scheduler) {
-  auto &allProcesses = scheduler.getProcesses();
-
-  // Need to sort all processes according to startTime
-  std::vector<size_t> sortedIndices(allProcesses.size());
-  std::iota(sortedIndices.begin(), sortedIndices.end(), 0);
-  std::sort(sortedIndices.begin(), sortedIndices.end(),
-            [&allProcesses](size_t a, size_t b) {
-              return allProcesses[a].startTime < allProcesses[b].startTime;
-            });
-
-  size_t nextToPush = 0;
-  auto &readyQueue = scheduler.getQueue();
-
-  while (!readyQueue.empty() || nextToPush < sortedIndices.size()) {
-    while (nextToPush < sortedIndices.size() &&
-           allProcesses[sortedIndices[nextToPush]].startTime <=
-               scheduler.getCurrentTime()) {
-      readyQueue.push_back(allProcesses[sortedIndices[nextToPush]].pid);
-      nextToPush++;
+  metrics.reset();
+  if (scheduler.getProgress().paused()) {
+    if (recorder != nullptr) {
+      recorder->clear();
     }
-
-    // If queue empty, need to fast-forward to next available process or stop if
-    // no processes are available
-    if (readyQueue.empty()) {
-      if (nextToPush < sortedIndices.size()) {
-        scheduler.setCurrentTime(
-            allProcesses[sortedIndices[nextToPush]].startTime);
-        continue;
+    runUntil(scheduler, UINT_MAX);
+    return;
+  }
+  const auto started = std::chrono::steady_clock::now();
+
+  runKernel(scheduler, [&](const WorkloadView &workload,
+                           std::span<unsigned int> remaining,
+                           std::span<int> end, unsigned int time) {
+    auto simulate = [&](auto &queue, auto &&observer) {
+      return simulateRoundRobin(workload, remaining, end, queue,
+                                RuntimeQuantum{timeQuantum}, time, observer);
+    };
+    // A recorded run queues through the recorder, which keeps every push
+    auto simulateRecorded = [&](auto &&observer) {
+      if (recorder == nullptr) {
+        return simulate(scheduler.getQueue(), observer);
       }
-      break;
+      auto queue = recorder->begin(workload.startTime, workload.burstTime,
+                                   timeQuantum, time);
+      const unsigned int finished = simulate(queue, observer);
+      recorder->end(queue);
+      return finished;
+    };
+    if constexpr (metricsEnabled) {
+      MetricsObserver observer(metrics, workload, end, timeQuantum);
+      const unsigned int finished = simulateRecorded(observer);
+      observer.flush();
+      return finished;
+    } else {
+      return simulateRecorded(NullObserver{});
     }
+  });
 
-    const auto pid = readyQueue.front();
-    readyQueue.pop_front();
-    auto &proc = scheduler.getProcess(pid);
-
-
-    // Give CPU time to first process in queue
-    const size_t runningTime = scheduler.processTimeSlice(proc, timeQuantum, sortedIndices, nextToPush);
+  if constexpr (metricsEnabled) {
+    metrics.runSeconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - started)
+                             .count();
+  }
+}
 
-    // Time quantum not enough - need to re-queue remaining part of process
-    if (proc.burstTime > 0) {
-      readyQueue.push_back(pid);
-    } else {
-      scheduler.markProcComplete(scheduler.getPIDToVecIndex()[pid],
-                                 scheduler.getCurrentTime());
+bool RoundRobinStrategy::runUntil(Scheduler &scheduler,
+                                  unsigned int stopTime) {
+  auto &procs = scheduler.getProcesses();
+  auto &progress = scheduler.getProgress();
+  if (!progress.paused()) {
+    if (procs.empty()) {
+      return true;
     }
+    scheduler.beginRun();
+    sortByArrival(procs.startTime, progress.arrivalOrder);
+    progress.nextArrival = 0;
+    progress.active = true;
+    scheduler.getQueue().clear();
+  }
 
-    // Update meta-data
-    scheduler.updateWaitingTimes(proc, runningTime);
+  const WorkloadView workload{procs.startTime, procs.burstTime,
+                              progress.arrivalOrder};
+  RoundRobinCursor cursor{scheduler.getCurrentTime(), progress.nextArrival};
+  const bool finished = resumeRoundRobin(
+      workload, procs.remainingTime, procs.endTime, scheduler.getQueue(),
+      RuntimeQuantum{timeQuantum}, cursor, stopTime);
+  scheduler.setCurrentTime(cursor.currentTime);
+  progress.nextArrival = cursor.nextArrival;
+
+  // Waiting times of the processes completed so far
+  procs.deriveWaitingTimes();
+  if (finished) {
+    progress.clear();
   }
+  return finished;
+}
+
+void RoundRobinStrategy::setTimeQuantum(unsigned int quantum) {
+  timeQuantum = quantum;
+}
+
+const SchedulerMetrics &RoundRobinStrategy::getMetrics() const {
+  return metrics;
+}
+
+void RoundRobinStrategy::setTraceRecorder(TraceRecorder *newRecorder) {
+  recorder = newRecorder;
+}
+
+// MLFQStrategy
+MLFQStrategy::MLFQStrategy(unsigned int baseQuantum, unsigned int levels,
+                           unsigned int boostInterval)
+    : baseQuantum(baseQuantum), levels(levels), boostInterval(boostInterval) {}
+
+void MLFQStrategy::run(Scheduler &scheduler) {
+  runKernel(scheduler, [&](const WorkloadView &workload,
+                           std::span<unsigned int> remaining,
+                           std::span<int> end, unsigned int time) {
+    return simulateMLFQ(workload, remaining, end, baseQuantum, levels,
+                        boostInterval, time, scheduler.getResource());
+  });
+}
+
+// SRTFStrategy
+void SRTFStrategy::run(Scheduler &scheduler) {
+  runKernel(scheduler, [&](const WorkloadView &workload,
+                           std::span<unsigned int> remaining,
+                           std::span<int> end, unsigned int time) {
+    return simulateSRTF(workload, remaining, end, time,
+                        scheduler.getResource());
+  });
+}
+
+// CFSStrategy
+CFSStrategy::CFSStrategy(unsigned int targetLatency,
+                         unsigned int minGranularity)
+    : targetLatency(targetLatency), minGranularity(minGranularity) {}
+
+void CFSStrategy::run(Scheduler &scheduler) {
+  runKernel(scheduler, [&](const WorkloadView &workload,
+                           std::span<unsigned int> remaining,
+                           std::span<int> end, unsigned int time) {
+    return simulateCFS(workload, remaining, end, targetLatency, minGranularity,
+                       time, scheduler.getResource());
+  });
 }
 
 // Factory implementation
-Scheduler *SchedulerFactory(SchedulerType type) {
+Scheduler *SchedulerFactory(SchedulerType type, const SchedulerParams &params) {
   switch (type) {
   case SchedulerType::RoundRobin:
-    return new Scheduler(new RoundRobinStrategy(4));
+    return new Scheduler(new RoundRobinStrategy(params.timeQuantum));
+  case SchedulerType::MLFQ:
+    return new Scheduler(new MLFQStrategy(
+        params.timeQuantum, params.mlfqLevels, params.boostInterval));
+  case SchedulerType::SRTF:
+    return new Scheduler(new SRTFStrategy());
+  case SchedulerType::CFS:
+    return new Scheduler(
+        new CFSStrategy(params.targetLatency, params.timeQuantum));
   default:
     return nullptr;
   }
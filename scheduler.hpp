@@ -1,10 +1,14 @@
 #pragma once
 
-#include <deque>
-#include <unordered_map>
+#include "containers.hpp"
+#include "metrics.hpp"
+#include <cstddef>
+#include <memory_resource>
+#include <span>
 #include <vector>
 
 class SchedulerStrategy;
+class TraceRecorder;
 
 struct Process {
   unsigned int pid;
@@ -16,40 +20,133 @@ struct Process {
   Process(unsigned int pid, unsigned int startTime, unsigned int burstTime);
 };
 
-class Scheduler {
-private:
-  unsigned int currentTime;
-  std::deque<unsigned int> readyQueue; // PIDs
-  std::vector<Process> allProcesses;
-  std::unordered_map<unsigned int, int> pidToVecIndex;
-  SchedulerStrategy *strategy;
+// Structure-of-arrays process storage. The scheduling loop only streams
+// through startTime and remainingTime; the remaining columns are read or
+// written once per process.
+struct ProcessTable {
+  // Hot
+  std::pmr::vector<unsigned int> startTime;
+  std::pmr::vector<unsigned int> remainingTime;
+  // Cold
+  std::pmr::vector<unsigned int> pid;
+  std::pmr::vector<unsigned int> burstTime; // Original burst, never modified
+  std::pmr::vector<int> waitingTime;
+  std::pmr::vector<int> endTime;
 
-public:
-  void setCurrentTime(const unsigned int newTime);
-  void updateWaitingTimes(const Process &currentProcess,
-                          const size_t runningTime);
+  ProcessTable() = default;
+  explicit ProcessTable(std::pmr::memory_resource *resource);
+
+  size_t size() const;
+  size_t capacity() const;
+  bool empty() const;
+  void reserve(size_t n);
+  void push_back(const Process &proc);
+  void clear();
+  // Puts every process back as it was before any run: the whole burst left
+  // and no results
+  void rewind();
+
+  // Fills waitingTime for every completed process. A process is either
+  // running or waiting between arrival and completion, so no per-slice
+  // bookkeeping is needed.
+  void deriveWaitingTimes();
+
+  // Assembles a Process from the columns at `idx`
+  Process operator[](size_t idx) const;
+};
+
+// How far a paused run has got, besides the time, the ready queue and the
+// per-process columns. Only round robin pauses (RoundRobinStrategy::runUntil).
+struct RunProgress {
+  // Scratch for every run; only meaningful while a run is paused
+  std::pmr::vector<size_t> arrivalOrder;
+  size_t nextArrival = 0; // Position in arrivalOrder
+  bool active = false;    // A run is paused part-way
+
+  bool paused() const { return active; }
+  void clear();
+};
+
+// Process storage and lookup shared by the runtime-polymorphic Scheduler and
+// the compile-time BasicScheduler. Every container allocates through one
+// counting memory resource, and reset() keeps their capacity, so a scheduler
+// that is reused for a workload it has seen before does not allocate at all.
+// Pass an arena (e.g. std::pmr::monotonic_buffer_resource) as `upstream` to
+// take even the first run's storage from it.
+class SchedulerBase {
+protected:
+  CountingResource memory; // Declared first: backs everything below
+  unsigned int currentTime;
+  RingBuffer<unsigned int> readyQueue; // Indices into allProcesses
+  ProcessTable allProcesses;
+  FlatPidMap pidToVecIndex; // Only used by the PID lookup API
+  RunProgress progress;
+  size_t lastRunAllocations = 0;
+  unsigned int runStart = 0; // Time the first run of this workload began
+  bool runStarted = false;
 
-  Process &getProcess(const unsigned int pid);
-  size_t processTimeSlice(Process &currentProcess,
-                          const unsigned int timeQuantum, const std::vector<size_t>& sortedIndices, size_t& nextToPush);
-  void markProcComplete(const unsigned int idx, const unsigned int currentTime);
+  size_t getIndex(const unsigned int pid) const;
+  void checkNotPaused() const;
 
 public:
-  Scheduler(SchedulerStrategy *strat);
-  ~Scheduler();
+  explicit SchedulerBase(
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+  SchedulerBase(const SchedulerBase &) = delete;
+  SchedulerBase &operator=(const SchedulerBase &) = delete;
 
-  std::deque<unsigned int> &getQueue();
-  std::vector<Process> &getProcesses();
-  std::unordered_map<unsigned int, int> &getPIDToVecIndex();
-  unsigned int getCurrentTime();
+  void setCurrentTime(const unsigned int newTime);
+  unsigned int getCurrentTime() const;
 
+  // Both throw std::runtime_error while a run is paused
   void addProcess(Process proc);
-  void run();
-  const Process &getProcess(unsigned int pid) const;
+  void addProcesses(std::span<const Process> procs);
+  void reserve(size_t n);
+  Process getProcess(const unsigned int pid) const;
   void printProcess(const unsigned int pid);
   void printQueue();
   void printProcessesMetaData();
+  // Drops every process but keeps all storage for the next workload
   void reset();
+  // Called before every run that starts from the beginning rather than
+  // continuing a paused one. The first records the time as the workload's
+  // start; later ones rewind the processes and the time to it, so the same
+  // workload can be rerun, e.g. with another quantum.
+  void beginRun();
+
+  // The resource backing the scheduler's storage; strategies take their
+  // per-run scratch from it too
+  std::pmr::memory_resource *getResource();
+  // Allocations made through getResource() so far, and during the last run()
+  size_t getAllocationCount() const;
+  size_t getLastRunAllocations() const;
+};
+
+class Scheduler : public SchedulerBase {
+private:
+  SchedulerStrategy *strategy;
+  bool ownsStrategy;
+
+public:
+  void markProcComplete(const size_t idx, const unsigned int currentTime);
+
+public:
+  // Takes ownership of `strat`
+  Scheduler(SchedulerStrategy *strat,
+            std::pmr::memory_resource *upstream =
+                std::pmr::get_default_resource());
+  // Runs `strat` without owning it, so the strategy can be a plain value
+  // that outlives the scheduler, and be reconfigured between runs
+  explicit Scheduler(SchedulerStrategy &strat,
+                     std::pmr::memory_resource *upstream =
+                         std::pmr::get_default_resource());
+  ~Scheduler();
+
+  RingBuffer<unsigned int> &getQueue();
+  ProcessTable &getProcesses();
+  FlatPidMap &getPIDToVecIndex();
+  RunProgress &getProgress();
+
+  void run();
 };
 
 class SchedulerStrategy {
@@ -61,11 +158,73 @@ public:
 class RoundRobinStrategy : public SchedulerStrategy {
 private:
   unsigned int timeQuantum;
+  SchedulerMetrics metrics;
+  TraceRecorder *recorder = nullptr;
 
 public:
   RoundRobinStrategy(unsigned int quantum);
+  // Runs to completion, continuing the scheduler's paused run if it has one
+  void run(Scheduler &scheduler) override;
+  // Takes effect from the next run or runUntil
+  void setTimeQuantum(unsigned int quantum);
+
+  // Runs only the slices that start before stopTime, then leaves the run
+  // paused so it can be checkpointed (see checkpoint.hpp) and continued by
+  // another runUntil or run, with any quantum. Returns true once every process
+  // has completed. Adding processes while a run is paused throws.
+  // Metrics and traces are only collected by a run() that starts and finishes
+  // the whole run.
+  bool runUntil(Scheduler &scheduler, unsigned int stopTime);
+
+  // Metrics of the last run. All zero if metrics are compiled out.
+  const SchedulerMetrics &getMetrics() const;
+
+  // Records every event of the following runs into `recorder`, which is
+  // cleared at the start of each run and must outlive them. nullptr stops
+  // recording.
+  void setTraceRecorder(TraceRecorder *recorder);
+};
+
+// Multi-level feedback queue with periodic priority boost. See simulateMLFQ.
+class MLFQStrategy : public SchedulerStrategy {
+private:
+  unsigned int baseQuantum;
+  unsigned int levels;
+  unsigned int boostInterval;
+
+public:
+  MLFQStrategy(unsigned int baseQuantum, unsigned int levels,
+               unsigned int boostInterval);
   void run(Scheduler &scheduler) override;
 };
 
-enum class SchedulerType { RoundRobin };
-Scheduler *SchedulerFactory(SchedulerType type);
+// Preemptive shortest-remaining-time-first. See simulateSRTF.
+class SRTFStrategy : public SchedulerStrategy {
+public:
+  void run(Scheduler &scheduler) override;
+};
+
+// Virtual-runtime fair scheduling in the style of Linux CFS. See simulateCFS.
+class CFSStrategy : public SchedulerStrategy {
+private:
+  unsigned int targetLatency;
+  unsigned int minGranularity;
+
+public:
+  CFSStrategy(unsigned int targetLatency, unsigned int minGranularity);
+  void run(Scheduler &scheduler) override;
+};
+
+enum class SchedulerType { RoundRobin, MLFQ, SRTF, CFS };
+
+// Knobs for SchedulerFactory. Each strategy reads the ones it needs.
+struct SchedulerParams {
+  // RR quantum, MLFQ top-level quantum and CFS minimum granularity
+  unsigned int timeQuantum = 4;
+  unsigned int mlfqLevels = 3;
+  unsigned int boostInterval = 1000; // 0 disables the MLFQ priority boost
+  unsigned int targetLatency = 24;   // CFS scheduling period
+};
+
+Scheduler *SchedulerFactory(SchedulerType type,
+                            const SchedulerParams &params = {});
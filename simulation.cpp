@@ -0,0 +1,337 @@
+#include "simulation.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+
+namespace {
+
+// Traces are usually written in arrival order, so check for that first. The
+// index breaks ties, which keeps std::sort stable without the scratch buffer
+// std::stable_sort would allocate.
+template <typename Vector>
+void fillArrivalOrder(std::span<const unsigned int> startTime, Vector &order) {
+  order.resize(startTime.size());
+  std::iota(order.begin(), order.end(), 0);
+  if (std::is_sorted(startTime.begin(), startTime.end())) {
+    return;
+  }
+  std::sort(order.begin(), order.end(), [&startTime](size_t a, size_t b) {
+    return startTime[a] != startTime[b] ? startTime[a] < startTime[b] : a < b;
+  });
+}
+
+} // namespace
+
+std::vector<size_t> sortByArrival(std::span<const unsigned int> startTime) {
+  std::vector<size_t> order;
+  fillArrivalOrder(startTime, order);
+  return order;
+}
+
+void sortByArrival(std::span<const unsigned int> startTime,
+                   std::pmr::vector<size_t> &order) {
+  fillArrivalOrder(startTime, order);
+}
+
+unsigned int simulateRoundRobin(const WorkloadView &workload,
+                                std::span<unsigned int> remainingTime,
+                                std::span<int> endTime,
+                                RingBuffer<unsigned int> &readyQueue,
+                                const unsigned int timeQuantum,
+                                unsigned int currentTime) {
+  return simulateRoundRobin(workload, remainingTime, endTime, readyQueue,
+                            RuntimeQuantum{timeQuantum}, currentTime);
+}
+
+namespace {
+
+// Per-level FIFOs for MLFQ. Each level is a chain of ring buffers taken from a
+// shared pool, so a priority boost splices whole chains onto level 0 in O(levels)
+// instead of moving every queued process. A bit per level tracks which levels
+// are non-empty, so picking the highest one is a single countr_zero.
+class FeedbackQueues {
+private:
+  std::pmr::memory_resource *resource;
+  std::pmr::vector<RingBuffer<unsigned int>> pool;
+  std::pmr::vector<unsigned int> freeBuffers;
+  std::pmr::vector<RingBuffer<unsigned int>> chains; // Buffer ids, oldest first
+  uint32_t nonEmpty = 0;
+
+  unsigned int acquire() {
+    if (freeBuffers.empty()) {
+      pool.emplace_back(resource);
+      return pool.size() - 1;
+    }
+    const unsigned int id = freeBuffers.back();
+    freeBuffers.pop_back();
+    return id;
+  }
+
+public:
+  FeedbackQueues(unsigned int levels, size_t expected,
+                 std::pmr::memory_resource *resource)
+      : resource(resource), pool(resource), freeBuffers(resource),
+        chains(resource) {
+    chains.reserve(levels);
+    for (unsigned int level = 0; level < levels; ++level) {
+      chains.emplace_back(resource).reserve(4);
+    }
+    const unsigned int first = acquire();
+    pool[first].reserve(expected);
+    freeBuffers.push_back(first);
+  }
+
+  bool empty() const { return nonEmpty == 0; }
+
+  unsigned int highest() const { return std::countr_zero(nonEmpty); }
+
+  void push(unsigned int level, unsigned int idx) {
+    auto &chain = chains[level];
+    if (chain.empty()) {
+      chain.push_back(acquire());
+      nonEmpty |= 1u << level;
+    }
+    // Always append to the newest buffer so the chain stays FIFO
+    pool[chain[chain.size() - 1]].push_back(idx);
+  }
+
+  unsigned int pop(unsigned int level) {
+    auto &chain = chains[level];
+    auto &buffer = pool[chain.front()];
+    const unsigned int idx = buffer.front();
+    buffer.pop_front();
+    if (buffer.empty()) {
+      freeBuffers.push_back(chain.front());
+      chain.pop_front();
+      if (chain.empty()) {
+        nonEmpty &= ~(1u << level);
+      }
+    }
+    return idx;
+  }
+
+  // Moves every lower level behind level 0, higher levels first
+  void boost() {
+    auto &top = chains[0];
+    for (size_t level = 1; level < chains.size(); ++level) {
+      auto &chain = chains[level];
+      while (!chain.empty()) {
+        top.push_back(chain.front());
+        chain.pop_front();
+      }
+    }
+    nonEmpty = nonEmpty != 0 ? 1u : 0u;
+  }
+};
+
+// Rounds `time` up to the next multiple of `interval` strictly after it
+uint64_t nextMultipleAfter(uint64_t time, unsigned int interval) {
+  return (time / interval + 1) * interval;
+}
+
+} // namespace
+
+unsigned int simulateMLFQ(const WorkloadView &workload,
+                          std::span<unsigned int> remainingTime,
+                          std::span<int> endTime, unsigned int baseQuantum,
+                          unsigned int levels, unsigned int boostInterval,
+                          unsigned int currentTime,
+                          std::pmr::memory_resource *resource) {
+  if (baseQuantum == 0) {
+    throw std::invalid_argument("MLFQ base quantum must be positive.");
+  }
+  if (levels == 0 || levels > 32) {
+    throw std::invalid_argument("MLFQ needs between 1 and 32 levels.");
+  }
+
+  const auto &startTime = workload.startTime;
+  const auto &order = workload.arrivalOrder;
+  size_t nextToPush = 0;
+  FeedbackQueues queues(levels, order.size(), resource);
+  uint64_t nextBoost =
+      boostInterval > 0 ? nextMultipleAfter(currentTime, boostInterval) : 0;
+
+  while (!queues.empty() || nextToPush < order.size()) {
+    while (nextToPush < order.size() &&
+           startTime[order[nextToPush]] <= currentTime) {
+      queues.push(0, order[nextToPush]);
+      nextToPush++;
+    }
+    if (boostInterval > 0 && currentTime >= nextBoost) {
+      queues.boost();
+      nextBoost = nextMultipleAfter(currentTime, boostInterval);
+    }
+
+    if (queues.empty()) {
+      currentTime = startTime[order[nextToPush]];
+      continue;
+    }
+
+    const unsigned int level = queues.highest();
+    const auto idx = queues.pop(level);
+    const uint64_t quantum = uint64_t{baseQuantum} << level;
+    const unsigned int runningTime =
+        std::min<uint64_t>(quantum, remainingTime[idx]);
+    remainingTime[idx] -= runningTime;
+    currentTime += runningTime;
+
+    while (nextToPush < order.size() &&
+           startTime[order[nextToPush]] <= currentTime) {
+      queues.push(0, order[nextToPush]);
+      nextToPush++;
+    }
+    if (remainingTime[idx] > 0) {
+      // Only reached when the whole quantum was used
+      queues.push(std::min(level + 1, levels - 1), idx);
+    } else {
+      endTime[idx] = currentTime;
+    }
+  }
+
+  return currentTime;
+}
+
+unsigned int simulateSRTF(const WorkloadView &workload,
+                          std::span<unsigned int> remainingTime,
+                          std::span<int> endTime, unsigned int currentTime,
+                          std::pmr::memory_resource *resource) {
+  const auto &startTime = workload.startTime;
+  const auto &order = workload.arrivalOrder;
+  size_t nextToPush = 0;
+
+  // Keys pack (remaining time, arrival rank) so the heap orders by remaining
+  // time and breaks ties by arrival; the process index is order[rank]
+  auto key = [&](size_t rank) {
+    return uint64_t{remainingTime[order[rank]]} << 32 | rank;
+  };
+  std::pmr::vector<uint64_t> storage(resource);
+  storage.reserve(order.size());
+  std::priority_queue<uint64_t, std::pmr::vector<uint64_t>, std::greater<>>
+      ready(std::greater<>{}, std::move(storage));
+
+  auto pushArrivals = [&]() {
+    while (nextToPush < order.size() &&
+           startTime[order[nextToPush]] <= currentTime) {
+      ready.push(key(nextToPush));
+      nextToPush++;
+    }
+  };
+
+  bool running = false;
+  size_t rank = 0;
+  while (running || !ready.empty() || nextToPush < order.size()) {
+    if (!running) {
+      if (ready.empty()) {
+        currentTime = std::max(currentTime, startTime[order[nextToPush]]);
+      }
+      pushArrivals();
+      rank = ready.top() & 0xffffffffu;
+      ready.pop();
+      running = true;
+    }
+
+    // Run until the process finishes or the next arrival, whichever is first
+    const auto idx = order[rank];
+    const uint64_t finish = uint64_t{currentTime} + remainingTime[idx];
+    if (nextToPush < order.size() && startTime[order[nextToPush]] < finish) {
+      const unsigned int arrival = startTime[order[nextToPush]];
+      remainingTime[idx] -= arrival - currentTime;
+      currentTime = arrival;
+      pushArrivals();
+      if ((ready.top() >> 32) < remainingTime[idx]) {
+        ready.push(key(rank));
+        rank = ready.top() & 0xffffffffu;
+        ready.pop();
+      }
+    } else {
+      currentTime = finish;
+      remainingTime[idx] = 0;
+      endTime[idx] = currentTime;
+      running = false;
+    }
+  }
+
+  return currentTime;
+}
+
+namespace {
+
+struct FairEntry {
+  uint64_t vruntime;
+  uint64_t seq; // FIFO among equal virtual runtimes
+  unsigned int idx;
+
+  bool operator>(const FairEntry &other) const {
+    return vruntime != other.vruntime ? vruntime > other.vruntime
+                                      : seq > other.seq;
+  }
+};
+
+} // namespace
+
+unsigned int simulateCFS(const WorkloadView &workload,
+                         std::span<unsigned int> remainingTime,
+                         std::span<int> endTime, unsigned int targetLatency,
+                         unsigned int minGranularity, unsigned int currentTime,
+                         std::pmr::memory_resource *resource) {
+  if (minGranularity == 0) {
+    throw std::invalid_argument("CFS minimum granularity must be positive.");
+  }
+
+  const auto &startTime = workload.startTime;
+  const auto &order = workload.arrivalOrder;
+  size_t nextToPush = 0;
+  uint64_t seq = 0;
+  uint64_t minVruntime = 0;
+
+  std::pmr::vector<FairEntry> storage(resource);
+  storage.reserve(order.size());
+  std::priority_queue<FairEntry, std::pmr::vector<FairEntry>, std::greater<>>
+      ready(std::greater<>{}, std::move(storage));
+
+  auto pushArrivals = [&]() {
+    while (nextToPush < order.size() &&
+           startTime[order[nextToPush]] <= currentTime) {
+      ready.push({minVruntime, seq++,
+                  static_cast<unsigned int>(order[nextToPush])});
+      nextToPush++;
+    }
+  };
+
+  while (!ready.empty() || nextToPush < order.size()) {
+    pushArrivals();
+    if (ready.empty()) {
+      currentTime = startTime[order[nextToPush]];
+      continue;
+    }
+
+    auto entry = ready.top();
+    ready.pop();
+    minVruntime = std::max(minVruntime, entry.vruntime);
+
+    const size_t runnable = ready.size() + 1;
+    const unsigned int slice = std::max<unsigned int>(
+        minGranularity, targetLatency / runnable);
+    const unsigned int runningTime =
+        std::min(slice, remainingTime[entry.idx]);
+    remainingTime[entry.idx] -= runningTime;
+    currentTime += runningTime;
+
+    // Arrivals during the slice are queued ahead of an equally charged
+    // preempted process, as with round-robin
+    pushArrivals();
+    if (remainingTime[entry.idx] > 0) {
+      entry.vruntime += runningTime;
+      entry.seq = seq++;
+      ready.push(entry);
+    } else {
+      endTime[entry.idx] = currentTime;
+    }
+  }
+
+  return currentTime;
+}
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "containers.hpp"
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Simulation kernels that work on plain arrays, so one read-only workload can
+// back many runs that each own only their mutable state.
+
+// Read-only view of a workload
+struct WorkloadView {
+  std::span<const unsigned int> startTime;
+  std::span<const unsigned int> burstTime;
+  std::span<const size_t> arrivalOrder; // Indices sorted by startTime
+};
+
+// Indices of `startTime` sorted by arrival. Processes arriving at the same
+// time keep their relative order.
+std::vector<size_t> sortByArrival(std::span<const unsigned int> startTime);
+// The same into `order`, which allocates only if it has to grow
+void sortByArrival(std::span<const unsigned int> startTime,
+                   std::pmr::vector<size_t> &order);
+
+// Decides how long the process at the head of the queue runs
+template <typename Policy>
+concept SlicePolicy = requires(const Policy &policy, unsigned int remaining) {
+  { policy.sliceLength(remaining) } -> std::convertible_to<unsigned int>;
+};
+
+// Quantum fixed at compile time, so the slice length folds into the loop
+template <unsigned int Quantum> struct FixedQuantum {
+  static_assert(Quantum > 0, "Quantum must be positive");
+  static constexpr unsigned int timeQuantum = Quantum;
+
+  static constexpr unsigned int sliceLength(unsigned int remaining) {
+    return remaining < Quantum ? remaining : Quantum;
+  }
+};
+
+// Quantum chosen at run time
+struct RuntimeQuantum {
+  unsigned int timeQuantum;
+
+  unsigned int sliceLength(unsigned int remaining) const {
+    return remaining < timeQuantum ? remaining : timeQuantum;
+  }
+};
+
+// Scheduling-loop hooks that do nothing, so they compile away
+struct NullObserver {
+  void onArrival(size_t, unsigned int) {}
+  void onIdle(unsigned int, unsigned int) {}
+  void onSlice(size_t, unsigned int, unsigned int) {}
+  void onPreempt(size_t, unsigned int) {}
+  void onComplete(size_t, unsigned int) {}
+  void onQueueLength(size_t) {}
+};
+
+// Forwards every hook to each of `observers` in order
+template <typename... Observers> struct ObserverList {
+  std::tuple<Observers &...> observers;
+
+  explicit ObserverList(Observers &...observers) : observers(observers...) {}
+
+  void onArrival(size_t idx, unsigned int time) {
+    std::apply([&](auto &...obs) { (obs.onArrival(idx, time), ...); },
+               observers);
+  }
+  void onIdle(unsigned int from, unsigned int to) {
+    std::apply([&](auto &...obs) { (obs.onIdle(from, to), ...); }, observers);
+  }
+  void onSlice(size_t idx, unsigned int start, unsigned int length) {
+    std::apply([&](auto &...obs) { (obs.onSlice(idx, start, length), ...); },
+               observers);
+  }
+  void onPreempt(size_t idx, unsigned int time) {
+    std::apply([&](auto &...obs) { (obs.onPreempt(idx, time), ...); },
+               observers);
+  }
+  void onComplete(size_t idx, unsigned int time) {
+    std::apply([&](auto &...obs) { (obs.onComplete(idx, time), ...); },
+               observers);
+  }
+  void onQueueLength(size_t length) {
+    std::apply([&](auto &...obs) { (obs.onQueueLength(length), ...); },
+               observers);
+  }
+};
+
+// Where a round-robin run stands between calls to resumeRoundRobin. The ready
+// queue and the per-process arrays hold the rest of its state.
+struct RoundRobinCursor {
+  unsigned int currentTime = 0;
+  size_t nextArrival = 0; // Position in arrivalOrder of the next arrival
+};
+
+// Continues a round-robin run from `cursor`, running only the slices that
+// start before stopTime, and advances the cursor. On the first call
+// remainingTime must hold the burst times and readyQueue must be empty; later
+// calls take both as the previous call left them. endTime receives completion
+// times. Returns true once every process has completed. `observer` is told
+// about arrivals (with their arrival time), idle gaps, slices (with their
+// start time), preemptions, completions and the queue length after each slice.
+// Any FIFO with RingBuffer's push_back/front/pop_front/empty/size/reserve can
+// stand in for the ready queue.
+template <SlicePolicy Policy, typename Observer = NullObserver,
+          typename Queue = RingBuffer<unsigned int>>
+bool resumeRoundRobin(const WorkloadView &workload,
+                      std::span<unsigned int> remainingTime,
+                      std::span<int> endTime, Queue &readyQueue,
+                      const Policy &policy, RoundRobinCursor &cursor,
+                      unsigned int stopTime = UINT_MAX,
+                      Observer &&observer = Observer{}) {
+  const auto &startTime = workload.startTime;
+  const auto &order = workload.arrivalOrder;
+  // Locals rather than the cursor's fields, so they stay in registers
+  unsigned int currentTime = cursor.currentTime;
+  size_t nextToPush = cursor.nextArrival;
+  readyQueue.reserve(order.size());
+
+  while (!readyQueue.empty() || nextToPush < order.size()) {
+    if (currentTime >= stopTime) {
+      break;
+    }
+    while (nextToPush < order.size() &&
+           startTime[order[nextToPush]] <= currentTime) {
+      observer.onArrival(order[nextToPush], startTime[order[nextToPush]]);
+      readyQueue.push_back(order[nextToPush]);
+      nextToPush++;
+    }
+
+    // If queue empty, need to fast-forward to next available process or stop if
+    // no processes are available
+    if (readyQueue.empty()) {
+      if (nextToPush < order.size()) {
+        observer.onIdle(currentTime, startTime[order[nextToPush]]);
+        currentTime = startTime[order[nextToPush]];
+        continue;
+      }
+      break;
+    }
+
+    const auto idx = readyQueue.front();
+    readyQueue.pop_front();
+
+    // Jump straight to the end of the slice instead of simulating every tick
+    const unsigned int runningTime = policy.sliceLength(remainingTime[idx]);
+    remainingTime[idx] -= runningTime;
+    currentTime += runningTime;
+    observer.onSlice(idx, currentTime - runningTime, runningTime);
+
+    // Merge in every process that arrived while this one was on the CPU, then
+    // re-queue it if the quantum was not enough
+    while (nextToPush < order.size() &&
+           startTime[order[nextToPush]] <= currentTime) {
+      observer.onArrival(order[nextToPush], startTime[order[nextToPush]]);
+      readyQueue.push_back(order[nextToPush]);
+      nextToPush++;
+    }
+    if (remainingTime[idx] > 0) {
+      readyQueue.push_back(idx);
+      observer.onPreempt(idx, currentTime);
+    } else {
+      endTime[idx] = currentTime;
+      observer.onComplete(idx, currentTime);
+    }
+    observer.onQueueLength(readyQueue.size());
+  }
+
+  cursor = {currentTime, nextToPush};
+  return readyQueue.empty() && nextToPush == order.size();
+}
+
+// Round-robin over `workload` starting at `currentTime`. remainingTime must
+// hold the burst times on entry and is consumed; endTime receives completion
+// times. readyQueue must be empty. Returns the time the last slice ended.
+// `observer` is notified as in resumeRoundRobin.
+template <SlicePolicy Policy, typename Observer = NullObserver,
+          typename Queue = RingBuffer<unsigned int>>
+unsigned int simulateRoundRobin(const WorkloadView &workload,
+                                std::span<unsigned int> remainingTime,
+                                std::span<int> endTime, Queue &readyQueue,
+                                const Policy &policy,
+                                unsigned int currentTime = 0,
+                                Observer &&observer = Observer{}) {
+  RoundRobinCursor cursor{currentTime, 0};
+  resumeRoundRobin(workload, remainingTime, endTime, readyQueue, policy, cursor,
+                   UINT_MAX, std::forward<Observer>(observer));
+  return cursor.currentTime;
+}
+
+// Round-robin with a run-time quantum
+unsigned int simulateRoundRobin(const WorkloadView &workload,
+                                std::span<unsigned int> remainingTime,
+                                std::span<int> endTime,
+                                RingBuffer<unsigned int> &readyQueue,
+                                const unsigned int timeQuantum,
+                                unsigned int currentTime = 0);
+
+// Multi-level feedback queue. Arrivals enter level 0, whose quantum is
+// baseQuantum; level k runs for baseQuantum << k. A process that uses its whole
+// quantum drops one level, down to levels - 1. Every boostInterval time units
+// (0 = never) all queued processes move back to level 0, keeping their order.
+// A slice is never cut short by an arrival. levels must be in [1, 32]. The
+// queues are allocated from `resource`.
+unsigned int simulateMLFQ(
+    const WorkloadView &workload, std::span<unsigned int> remainingTime,
+    std::span<int> endTime, unsigned int baseQuantum, unsigned int levels,
+    unsigned int boostInterval, unsigned int currentTime = 0,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+// Preemptive shortest-remaining-time-first. The running process is preempted
+// only by an arrival with strictly less remaining time; ties go to the
+// earlier arrival. The heap is allocated from `resource`.
+unsigned int simulateSRTF(
+    const WorkloadView &workload, std::span<unsigned int> remainingTime,
+    std::span<int> endTime, unsigned int currentTime = 0,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+// CFS-like fair scheduling. The process with the least virtual runtime runs
+// for max(minGranularity, targetLatency / runnable) and is charged for it.
+// Arrivals start at the smallest virtual runtime seen so far, so they neither
+// starve nor get starved by processes that have been queued for a while. The
+// heap is allocated from `resource`.
+unsigned int simulateCFS(
+    const WorkloadView &workload, std::span<unsigned int> remainingTime,
+    std::span<int> endTime, unsigned int targetLatency,
+    unsigned int minGranularity, unsigned int currentTime = 0,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
@@ -0,0 +1,114 @@
+#include "streaming_scheduler.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+StreamingScheduler::StreamingScheduler(unsigned int quantum)
+    : timeQuantum(quantum) {}
+
+unsigned int StreamingScheduler::allocateSlot(const Process &proc) {
+  if (freeSlots.empty()) {
+    slots.push_back(proc);
+    return slots.size() - 1;
+  }
+
+  const auto slot = freeSlots.back();
+  freeSlots.pop_back();
+  slots.startTime[slot] = proc.startTime;
+  slots.remainingTime[slot] = proc.burstTime;
+  slots.pid[slot] = proc.pid;
+  slots.burstTime[slot] = proc.burstTime;
+  slots.waitingTime[slot] = 0;
+  slots.endTime[slot] = -1;
+  return slot;
+}
+
+void StreamingScheduler::submit(const Process &proc) {
+  if (proc.burstTime == 0) {
+    return;
+  }
+  if (horizonSet && proc.startTime <= horizon) {
+    throw std::invalid_argument(
+        "Process arrives before the time already advanced to.");
+  }
+  if (!pending.empty() &&
+      proc.startTime < slots.startTime[pending[pending.size() - 1]]) {
+    throw std::invalid_argument("Processes must be submitted in arrival order.");
+  }
+
+  pending.push_back(allocateSlot(proc));
+}
+
+void StreamingScheduler::admitArrivals() {
+  while (!pending.empty() && slots.startTime[pending.front()] <= currentTime) {
+    readyQueue.push_back(pending.front());
+    pending.pop_front();
+  }
+}
+
+void StreamingScheduler::complete(const unsigned int slot) {
+  slots.endTime[slot] = currentTime;
+  slots.waitingTime[slot] =
+      currentTime - slots.startTime[slot] - slots.burstTime[slot];
+  completed.push_back(slots[slot]);
+  freeSlots.push_back(slot);
+}
+
+void StreamingScheduler::advanceTo(const unsigned int time) {
+  if (horizonSet && time < horizon) {
+    throw std::invalid_argument("Cannot advance to an earlier time.");
+  }
+  horizon = time;
+  horizonSet = true;
+
+  while (true) {
+    admitArrivals();
+
+    // Idle CPU: fast-forward to the next known arrival
+    if (readyQueue.empty()) {
+      if (!pending.empty() && slots.startTime[pending.front()] <= horizon) {
+        currentTime = slots.startTime[pending.front()];
+        continue;
+      }
+      break;
+    }
+
+    // Arrivals after the horizon are not known yet, so a slice may only run
+    // if it ends by then
+    const auto slot = readyQueue.front();
+    const unsigned int runningTime =
+        std::min(timeQuantum, slots.remainingTime[slot]);
+    if (static_cast<unsigned long long>(currentTime) + runningTime > horizon) {
+      break;
+    }
+
+    readyQueue.pop_front();
+    slots.remainingTime[slot] -= runningTime;
+    currentTime += runningTime;
+
+    // Same ordering as RoundRobinStrategy: arrivals during the slice are
+    // queued before the preempted process
+    admitArrivals();
+    if (slots.remainingTime[slot] > 0) {
+      readyQueue.push_back(slot);
+    } else {
+      complete(slot);
+    }
+  }
+}
+
+void StreamingScheduler::finish() {
+  advanceTo(std::numeric_limits<unsigned int>::max());
+}
+
+std::vector<Process> StreamingScheduler::drainCompleted() {
+  std::vector<Process> out;
+  out.swap(completed);
+  return out;
+}
+
+unsigned int StreamingScheduler::getCurrentTime() const { return currentTime; }
+
+size_t StreamingScheduler::liveProcesses() const {
+  return slots.size() - freeSlots.size();
+}
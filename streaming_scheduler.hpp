@@ -0,0 +1,48 @@
+#pragma once
+
+#include "containers.hpp"
+#include "scheduler.hpp"
+#include <vector>
+
+// Online round-robin scheduler for unbounded arrival streams.
+//
+// Processes are submitted in arrival order while the simulation runs.
+// advanceTo(t) is the caller's promise that every process arriving at or
+// before t has been submitted; the scheduler then runs every slice that ends
+// by t. Completed processes are handed back by drainCompleted() and their
+// slots are reused, so memory tracks the number of live processes rather than
+// the length of the stream. Results match Scheduler::run with
+// RoundRobinStrategy on the same workload.
+class StreamingScheduler {
+private:
+  unsigned int timeQuantum;
+  unsigned int currentTime = 0;
+  unsigned int horizon = 0;
+  bool horizonSet = false;
+
+  ProcessTable slots;                   // Live processes, indexed by slot
+  std::vector<unsigned int> freeSlots;  // Slots of completed processes
+  RingBuffer<unsigned int> pending;     // Submitted, not yet arrived
+  RingBuffer<unsigned int> readyQueue;  // Arrived, waiting for the CPU
+  std::vector<Process> completed;
+
+  unsigned int allocateSlot(const Process &proc);
+  void admitArrivals();
+  void complete(const unsigned int slot);
+
+public:
+  StreamingScheduler(unsigned int quantum);
+
+  // Queues a process for arrival. Arrivals must be non-decreasing and later
+  // than any time already passed to advanceTo.
+  void submit(const Process &proc);
+  // Runs the simulation as far as the arrivals known up to `time` allow
+  void advanceTo(const unsigned int time);
+  // Ends the stream and runs every remaining process to completion
+  void finish();
+  // Returns processes completed since the last call, in completion order
+  std::vector<Process> drainCompleted();
+
+  unsigned int getCurrentTime() const;
+  size_t liveProcesses() const;
+};
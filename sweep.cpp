@@ -0,0 +1,199 @@
+#include "sweep.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+// Workload
+Workload::Workload(std::span<const Process> procs) {
+  for (const auto &proc : procs) {
+    if (proc.burstTime > 0) {
+      pid.push_back(proc.pid);
+      startTime.push_back(proc.startTime);
+      burstTime.push_back(proc.burstTime);
+    }
+  }
+  arrivalOrder = sortByArrival(startTime);
+}
+
+WorkloadView Workload::view() const {
+  return WorkloadView{startTime, burstTime, arrivalOrder};
+}
+
+size_t Workload::size() const { return pid.size(); }
+
+namespace {
+
+// Mutable state private to one worker thread, reused across its runs
+struct RunBuffers {
+  std::vector<unsigned int> remainingTime;
+  std::vector<int> endTime;
+  std::vector<unsigned int> samples;
+  RingBuffer<unsigned int> readyQueue;
+};
+
+// Mean and 99th percentile of `samples`; reorders them
+std::pair<double, unsigned int> summarize(std::vector<unsigned int> &samples) {
+  if (samples.empty()) {
+    return {0.0, 0};
+  }
+  double sum = 0;
+  for (const auto value : samples) {
+    sum += value;
+  }
+  const size_t rank = (samples.size() * 99 + 99) / 100 - 1;
+  std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+  return {sum / samples.size(), samples[rank]};
+}
+
+SweepResult simulatePoint(const WorkloadView &workload, const SweepPoint &point,
+                          RunBuffers &buffers) {
+  const size_t n = workload.startTime.size();
+  buffers.remainingTime.assign(workload.burstTime.begin(),
+                               workload.burstTime.end());
+  buffers.endTime.assign(n, -1);
+  buffers.readyQueue.clear();
+
+  // Only the quantum varies; every other knob keeps its factory default
+  SchedulerParams params;
+  params.timeQuantum = point.timeQuantum;
+
+  unsigned int makespan = 0;
+  switch (point.type) {
+  case SchedulerType::RoundRobin:
+    makespan = simulateRoundRobin(workload, buffers.remainingTime,
+                                  buffers.endTime, buffers.readyQueue,
+                                  params.timeQuantum);
+    break;
+  case SchedulerType::MLFQ:
+    makespan = simulateMLFQ(workload, buffers.remainingTime, buffers.endTime,
+                            params.timeQuantum, params.mlfqLevels,
+                            params.boostInterval);
+    break;
+  case SchedulerType::SRTF:
+    makespan =
+        simulateSRTF(workload, buffers.remainingTime, buffers.endTime);
+    break;
+  case SchedulerType::CFS:
+    makespan = simulateCFS(workload, buffers.remainingTime, buffers.endTime,
+                           params.targetLatency, params.timeQuantum);
+    break;
+  default:
+    throw std::invalid_argument("Scheduler type not supported by sweeps.");
+  }
+
+  SweepResult result{point, 0.0, 0, 0.0, 0, makespan};
+  auto &samples = buffers.samples;
+  samples.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    samples[i] = buffers.endTime[i] - workload.startTime[i];
+  }
+  std::tie(result.meanTurnaroundTime, result.p99TurnaroundTime) =
+      summarize(samples);
+  for (size_t i = 0; i < n; ++i) {
+    samples[i] =
+        buffers.endTime[i] - workload.startTime[i] - workload.burstTime[i];
+  }
+  std::tie(result.meanWaitingTime, result.p99WaitingTime) = summarize(samples);
+  return result;
+}
+
+} // namespace
+
+std::vector<SweepPoint> makeSweepGrid(std::span<const SchedulerType> types,
+                                      std::span<const unsigned int> quanta) {
+  std::vector<SweepPoint> points;
+  points.reserve(types.size() * quanta.size());
+  for (const auto type : types) {
+    for (const auto quantum : quanta) {
+      points.push_back({type, quantum});
+    }
+  }
+  return points;
+}
+
+std::vector<SweepResult> runSweep(const Workload &workload,
+                                  std::span<const SweepPoint> points,
+                                  unsigned int threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  threads = std::min<unsigned int>(threads, points.size());
+
+  const WorkloadView view = workload.view();
+  std::vector<SweepResult> results(points.size());
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::mutex errorMutex;
+
+  // Workers pull the next point until none are left, so long and short runs
+  // balance across threads
+  auto worker = [&]() {
+    RunBuffers buffers;
+    try {
+      for (size_t i = next++; i < points.size(); i = next++) {
+        results[i] = simulatePoint(view, points[i], buffers);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(errorMutex);
+      error = std::current_exception();
+      next = points.size();
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads);
+  for (unsigned int t = 1; t < threads; ++t) {
+    pool.emplace_back(worker);
+  }
+  worker(); // The calling thread works too
+  for (auto &thread : pool) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return results;
+}
+
+static const char *schedulerTypeName(SchedulerType type) {
+  switch (type) {
+  case SchedulerType::RoundRobin:
+    return "RoundRobin";
+  case SchedulerType::MLFQ:
+    return "MLFQ";
+  case SchedulerType::SRTF:
+    return "SRTF";
+  case SchedulerType::CFS:
+    return "CFS";
+  default:
+    return "Unknown";
+  }
+}
+
+void printSweepResults(std::span<const SweepResult> results) {
+  const auto flags = std::cout.flags();
+  const auto precision = std::cout.precision();
+  std::cout << std::setw(12) << "Strategy" << std::setw(12) << "Quantum"
+            << std::setw(12) << "MeanWait" << std::setw(12) << "P99Wait"
+            << std::setw(12) << "MeanTurn" << std::setw(12) << "P99Turn"
+            << std::setw(12) << "Makespan\n";
+  for (const auto &res : results) {
+    std::cout << std::setw(12) << schedulerTypeName(res.point.type)
+              << std::setw(12) << res.point.timeQuantum << std::setw(12)
+              << std::fixed << std::setprecision(1) << res.meanWaitingTime
+              << std::setw(12) << res.p99WaitingTime << std::setw(12)
+              << res.meanTurnaroundTime << std::setw(12)
+              << res.p99TurnaroundTime << std::setw(12) << res.makespan
+              << "\n";
+  }
+  std::cout.flags(flags);
+  std::cout.precision(precision);
+}
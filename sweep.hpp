@@ -0,0 +1,51 @@
+#pragma once
+
+#include "scheduler.hpp"
+#include "simulation.hpp"
+#include <span>
+#include <vector>
+
+// Immutable workload shared by every run of a sweep. Processes with a zero
+// burst are dropped, as with Scheduler::addProcess.
+class Workload {
+private:
+  std::vector<unsigned int> pid;
+  std::vector<unsigned int> startTime;
+  std::vector<unsigned int> burstTime;
+  std::vector<size_t> arrivalOrder;
+
+public:
+  explicit Workload(std::span<const Process> procs);
+
+  WorkloadView view() const;
+  size_t size() const;
+};
+
+// One configuration to simulate. timeQuantum is used as
+// SchedulerParams::timeQuantum; the other parameters keep their defaults.
+struct SweepPoint {
+  SchedulerType type;
+  unsigned int timeQuantum;
+};
+
+struct SweepResult {
+  SweepPoint point;
+  double meanWaitingTime;
+  unsigned int p99WaitingTime;
+  double meanTurnaroundTime;
+  unsigned int p99TurnaroundTime;
+  unsigned int makespan;
+};
+
+// Every combination of `types` and `quanta`
+std::vector<SweepPoint> makeSweepGrid(std::span<const SchedulerType> types,
+                                      std::span<const unsigned int> quanta);
+
+// Simulates every point on `threads` worker threads (0 = all host cores).
+// Workers read the shared workload in place and reuse their own scratch
+// buffers between runs. Results are returned in the order of `points`.
+std::vector<SweepResult> runSweep(const Workload &workload,
+                                  std::span<const SweepPoint> points,
+                                  unsigned int threads = 0);
+
+void printSweepResults(std::span<const SweepResult> results);
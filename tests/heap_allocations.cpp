@@ -0,0 +1,40 @@
+#include "heap_allocations.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// The replaced operators live in their own file so GCC never inlines a
+// std::free against the operator new it sees at the call site, which
+// -Wmismatched-new-delete reports. Atomic because the executor and sweep
+// tests allocate on worker threads.
+static std::atomic<size_t> allocations{0};
+
+size_t heapAllocations() { return allocations.load(std::memory_order_relaxed); }
+
+void *operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+// std::pmr::new_delete_resource() allocates through the aligned form
+void *operator new(size_t size, std::align_val_t align) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  const auto alignment = static_cast<size_t>(align);
+  const size_t rounded = (std::max<size_t>(size, 1) + alignment - 1) /
+                         alignment * alignment;
+  if (void *ptr = std::aligned_alloc(alignment, rounded)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cstddef>
+
+// Heap allocations made by the test binary so far, from any thread
+size_t heapAllocations();
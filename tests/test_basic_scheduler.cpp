@@ -0,0 +1,64 @@
+#include "../basic_scheduler.hpp"
+#include "workload.hpp"
+#include <gtest/gtest.h>
+#include <random>
+
+TEST(BasicSchedulerTest, MixedArrivalTimes) {
+  BasicScheduler<FixedQuantum<3>> scheduler;
+  scheduler.addProcess({0, 0, 5});
+  scheduler.addProcess({1, 2, 4});
+  scheduler.addProcess({2, 5, 2});
+  scheduler.run();
+
+  EXPECT_EQ(scheduler.getProcess(0).endTime, 8);
+  EXPECT_EQ(scheduler.getProcess(1).endTime, 11);
+  EXPECT_EQ(scheduler.getProcess(2).endTime, 10);
+  EXPECT_EQ(scheduler.getProcess(1).waitingTime, 5);
+  EXPECT_EQ(scheduler.getCurrentTime(), 11u);
+}
+
+TEST(BasicSchedulerTest, MatchesRuntimeScheduler) {
+  std::mt19937 rng(23);
+  const auto procs = randomWorkload(rng, 300, 400, 30);
+
+  BasicScheduler<FixedQuantum<4>> fixed;
+  BasicScheduler<RuntimeQuantum> runtime(RuntimeQuantum{4});
+  Scheduler scheduler(new RoundRobinStrategy(4));
+  fixed.addProcesses(procs);
+  runtime.addProcesses(procs);
+  scheduler.addProcesses(procs);
+  fixed.run();
+  runtime.run();
+  scheduler.run();
+
+  for (const auto &proc : procs) {
+    const auto expected = scheduler.getProcess(proc.pid);
+    EXPECT_EQ(fixed.getProcess(proc.pid).endTime, expected.endTime);
+    EXPECT_EQ(fixed.getProcess(proc.pid).waitingTime, expected.waitingTime);
+    EXPECT_EQ(runtime.getProcess(proc.pid).endTime, expected.endTime);
+  }
+  EXPECT_EQ(fixed.getCurrentTime(), scheduler.getCurrentTime());
+}
+
+TEST(BasicSchedulerTest, RerunStartsFromTheBeginning) {
+  BasicScheduler<FixedQuantum<2>> scheduler;
+  scheduler.addProcess({0, 0, 3});
+  scheduler.addProcess({1, 1, 3});
+  scheduler.run();
+  const int firstEnd = scheduler.getProcess(1).endTime;
+
+  scheduler.run();
+  EXPECT_EQ(scheduler.getProcess(1).endTime, firstEnd);
+  EXPECT_EQ(scheduler.getCurrentTime(), 6u);
+}
+
+TEST(BasicSchedulerTest, ResetClearsState) {
+  BasicScheduler<FixedQuantum<2>> scheduler;
+  scheduler.addProcess({0, 0, 3});
+  scheduler.run();
+  scheduler.reset();
+
+  EXPECT_EQ(scheduler.getCurrentTime(), 0u);
+  EXPECT_TRUE(scheduler.getProcesses().empty());
+  EXPECT_THROW(scheduler.getProcess(0), std::out_of_range);
+}
@@ -0,0 +1,110 @@
+#include "../batch_simulation.hpp"
+#include "workload.hpp"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+// Mostly 5-50 processes, with a few empty, single and oversized workloads
+std::vector<std::vector<Process>> randomWorkloads(size_t count,
+                                                  unsigned int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<size_t> size(5, 50);
+  std::vector<std::vector<Process>> workloads(count);
+  for (size_t w = 0; w < count; ++w) {
+    size_t n = size(rng);
+    if (w % 97 == 0) {
+      n = 0;
+    } else if (w % 89 == 0) {
+      n = 1;
+    } else if (w % 83 == 0) {
+      n = 150;
+    }
+    workloads[w] = randomWorkload(rng, n, 200, 25, 0); // Some zero bursts
+  }
+  return workloads;
+}
+
+std::vector<BatchBackend> supportedBackends() {
+  std::vector<BatchBackend> backends;
+  for (const auto backend : {BatchBackend::Scalar, BatchBackend::Avx2,
+                             BatchBackend::Avx512, BatchBackend::Auto}) {
+    if (batchBackendSupported(backend)) {
+      backends.push_back(backend);
+    }
+  }
+  return backends;
+}
+
+} // namespace
+
+TEST(BatchSimulationTest, EveryBackendMatchesScheduler) {
+  const auto workloads = randomWorkloads(600, 4);
+  WorkloadBatch batch;
+  for (const auto &procs : workloads) {
+    batch.add(procs);
+  }
+  ASSERT_EQ(batch.size(), workloads.size());
+
+  for (const unsigned int quantum : {1u, 3u, 10u}) {
+    for (const auto backend : supportedBackends()) {
+      BatchResults results;
+      simulateBatch(batch, quantum, results, backend);
+      size_t row = 0;
+      for (const auto &procs : workloads) {
+        Scheduler scheduler(new RoundRobinStrategy(quantum));
+        scheduler.addProcesses(procs);
+        scheduler.run();
+        for (const auto &proc : procs) {
+          if (proc.burstTime == 0) {
+            EXPECT_EQ(results.endTime[row], -1);
+          } else {
+            const auto want = scheduler.getProcess(proc.pid);
+            ASSERT_EQ(results.endTime[row], want.endTime)
+                << "backend " << static_cast<int>(backend) << " row " << row;
+            ASSERT_EQ(results.waitingTime[row], want.waitingTime)
+                << "backend " << static_cast<int>(backend) << " row " << row;
+          }
+          row++;
+        }
+      }
+    }
+  }
+}
+
+TEST(BatchSimulationTest, IdleGapsAndLateStarts) {
+  // Lanes go idle at different times and for different lengths
+  WorkloadBatch batch;
+  std::vector<std::vector<Process>> workloads;
+  for (unsigned int w = 0; w < 40; ++w) {
+    workloads.push_back({{0, 1000 * w, 3}, {1, 1000 * w + 500, 7}, {2, 5, 1}});
+    batch.add(workloads.back());
+  }
+  for (const auto backend : supportedBackends()) {
+    BatchResults results;
+    simulateBatch(batch, 2, results, backend);
+    for (size_t w = 0; w < workloads.size(); ++w) {
+      Scheduler scheduler(new RoundRobinStrategy(2));
+      scheduler.addProcesses(workloads[w]);
+      scheduler.run();
+      for (unsigned int pid = 0; pid < 3; ++pid) {
+        EXPECT_EQ(results.endTime[3 * w + pid],
+                  scheduler.getProcess(pid).endTime);
+      }
+    }
+  }
+}
+
+TEST(BatchSimulationTest, RejectsBadArguments) {
+  WorkloadBatch batch;
+  batch.add(std::vector<Process>{{0, 0, 4}});
+  BatchResults results;
+  EXPECT_THROW(simulateBatch(batch, 0, results), std::invalid_argument);
+  for (const auto backend : {BatchBackend::Avx2, BatchBackend::Avx512}) {
+    if (!batchBackendSupported(backend)) {
+      EXPECT_THROW(simulateBatch(batch, 4, results, backend),
+                   std::invalid_argument);
+    }
+  }
+  EXPECT_TRUE(batchBackendSupported(BatchBackend::Scalar));
+}
@@ -0,0 +1,193 @@
+#include "../checkpoint.hpp"
+#include "workload.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+std::string tempPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void expectSameResults(Scheduler &actual, Scheduler &expected,
+                       const std::vector<Process> &procs) {
+  for (const auto &proc : procs) {
+    const auto got = actual.getProcess(proc.pid);
+    const auto want = expected.getProcess(proc.pid);
+    EXPECT_EQ(got.endTime, want.endTime) << "pid " << proc.pid;
+    EXPECT_EQ(got.waitingTime, want.waitingTime) << "pid " << proc.pid;
+  }
+  EXPECT_EQ(actual.getCurrentTime(), expected.getCurrentTime());
+}
+
+} // namespace
+
+TEST(RunUntilTest, PausedRunsMatchOneRun) {
+  std::mt19937 rng(3);
+  const auto procs = randomWorkload(rng, 2000, 5000, 30);
+  Scheduler reference(new RoundRobinStrategy(4));
+  reference.addProcesses(procs);
+  reference.run();
+
+  auto *strategy = new RoundRobinStrategy(4);
+  Scheduler paused(strategy);
+  paused.addProcesses(procs);
+  unsigned int stopTime = 0;
+  while (!strategy->runUntil(paused, stopTime += 997)) {
+    EXPECT_TRUE(paused.getProgress().paused());
+  }
+  EXPECT_FALSE(paused.getProgress().paused());
+  expectSameResults(paused, reference, procs);
+}
+
+TEST(RunUntilTest, AddingProcessesWhilePausedThrows) {
+  auto *strategy = new RoundRobinStrategy(2);
+  Scheduler scheduler(strategy);
+  scheduler.addProcess({0, 0, 5});
+  ASSERT_FALSE(strategy->runUntil(scheduler, 1));
+  EXPECT_THROW(scheduler.addProcess({1, 0, 3}), std::runtime_error);
+  const std::vector<Process> more = {{2, 0, 3}};
+  EXPECT_THROW(scheduler.addProcesses(more), std::runtime_error);
+
+  scheduler.run();
+  EXPECT_EQ(scheduler.getProcess(0).endTime, 5);
+  EXPECT_THROW(scheduler.getProcess(1), std::out_of_range);
+  scheduler.addProcess({1, 0, 3}); // Fine once the run has finished
+}
+
+TEST(RunUntilTest, RunsAfterAFinishedRunStartOver) {
+  std::mt19937 rng(4);
+  const auto procs = randomWorkload(rng, 500, 5000, 30);
+  Scheduler reference(new RoundRobinStrategy(4));
+  reference.addProcesses(procs);
+  reference.run();
+
+  auto *strategy = new RoundRobinStrategy(4);
+  Scheduler scheduler(strategy);
+  scheduler.addProcesses(procs);
+  scheduler.run();
+  ASSERT_FALSE(strategy->runUntil(scheduler, 1000));
+  EXPECT_LT(scheduler.getCurrentTime(), reference.getCurrentTime());
+  scheduler.run();
+  expectSameResults(scheduler, reference, procs);
+
+  // A restored run reruns from time 0 once it has finished
+  Scheduler fork(new RoundRobinStrategy(4));
+  ASSERT_FALSE(strategy->runUntil(scheduler, 1000));
+  Checkpoint::capture(scheduler).restore(fork);
+  fork.run();
+  fork.run();
+  expectSameResults(fork, reference, procs);
+}
+
+TEST(CheckpointTest, CapturesThePausedState) {
+  auto *strategy = new RoundRobinStrategy(3);
+  Scheduler scheduler(strategy);
+  scheduler.addProcess({0, 0, 5});
+  scheduler.addProcess({1, 2, 4});
+  scheduler.addProcess({2, 5, 2});
+
+  // P0 0-3, then P1 3-6 is the last slice to start before 5
+  EXPECT_FALSE(strategy->runUntil(scheduler, 5));
+  const auto checkpoint = Checkpoint::capture(scheduler);
+  EXPECT_EQ(checkpoint.getCurrentTime(), 6u);
+  EXPECT_EQ(checkpoint.size(), 3u);
+  EXPECT_EQ(checkpoint.queueLength(), 3u);
+
+  // Continue with a different quantum: P0 6-7, P2 7-8, P1 8-9, P0 9-10,
+  // P2 10-11
+  auto *whatIf = new RoundRobinStrategy(1);
+  Scheduler fork(whatIf);
+  checkpoint.restore(fork);
+  EXPECT_EQ(fork.getCurrentTime(), 6u);
+  std::vector<unsigned int> queue;
+  for (const auto idx : fork.getQueue()) {
+    queue.push_back(idx);
+  }
+  EXPECT_EQ(queue, (std::vector<unsigned int>{0, 2, 1}));
+  fork.run();
+  EXPECT_EQ(fork.getProcess(1).endTime, 9);
+  EXPECT_EQ(fork.getProcess(0).endTime, 10);
+  EXPECT_EQ(fork.getProcess(2).endTime, 11);
+  EXPECT_EQ(fork.getProcess(0).waitingTime, 5);
+
+  // The original run is untouched by the fork
+  scheduler.run();
+  EXPECT_EQ(scheduler.getProcess(0).endTime, 8);
+  EXPECT_EQ(scheduler.getProcess(2).endTime, 10);
+  EXPECT_EQ(scheduler.getProcess(1).endTime, 11);
+}
+
+TEST(CheckpointTest, ResumeFromFileMatchesOneRun) {
+  std::mt19937 rng(11);
+  const auto procs = randomWorkload(rng, 3000, 5000, 30);
+  Scheduler reference(new RoundRobinStrategy(5));
+  reference.addProcesses(procs);
+  reference.run();
+
+  auto *strategy = new RoundRobinStrategy(5);
+  Scheduler first(strategy);
+  first.addProcesses(procs);
+  ASSERT_FALSE(strategy->runUntil(first, 2500));
+  const auto path = tempPath("rr_checkpoint_test.bin");
+  Checkpoint::capture(first).save(path);
+
+  // Several forks of one mapped checkpoint
+  const auto checkpoint = Checkpoint::load(path);
+  for (int i = 0; i < 2; ++i) {
+    Scheduler resumed(new RoundRobinStrategy(5));
+    checkpoint.restore(resumed);
+    EXPECT_EQ(resumed.getCurrentTime(), first.getCurrentTime());
+    resumed.run();
+    expectSameResults(resumed, reference, procs);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(CheckpointTest, CaptureNeedsAPausedRun) {
+  Scheduler scheduler(new RoundRobinStrategy(2));
+  scheduler.addProcess({0, 0, 3});
+  EXPECT_THROW(Checkpoint::capture(scheduler), std::invalid_argument);
+  scheduler.run();
+  EXPECT_THROW(Checkpoint::capture(scheduler), std::invalid_argument);
+}
+
+TEST(CheckpointTest, LoadRejectsDamagedFiles) {
+  auto *strategy = new RoundRobinStrategy(2);
+  Scheduler scheduler(strategy);
+  scheduler.addProcess({0, 0, 3});
+  scheduler.addProcess({1, 0, 3});
+  strategy->runUntil(scheduler, 1);
+  const auto path = tempPath("rr_checkpoint_damaged.bin");
+  Checkpoint::capture(scheduler).save(path);
+
+  // Each patch starts from the header as saved
+  CheckpointHeader saved;
+  std::ifstream(path, std::ios::binary)
+      .read(reinterpret_cast<char *>(&saved), sizeof(saved));
+  auto patchHeader = [&path, &saved](auto patch) {
+    CheckpointHeader header = saved;
+    patch(header);
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  };
+  // Counts so large that sizing the body from them would overflow
+  patchHeader([](CheckpointHeader &h) { h.processCount = 1ull << 62; });
+  EXPECT_THROW(Checkpoint::load(path), std::runtime_error);
+  patchHeader([](CheckpointHeader &h) { h.queueLength = ~0ull; });
+  EXPECT_THROW(Checkpoint::load(path), std::runtime_error);
+  // Version 1 stored the PID map's slot table
+  patchHeader([](CheckpointHeader &h) { h.version = 1; });
+  EXPECT_THROW(Checkpoint::load(path), std::runtime_error);
+  patchHeader([](CheckpointHeader &) {});
+  EXPECT_NO_THROW(Checkpoint::load(path));
+
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+  EXPECT_THROW(Checkpoint::load(path), std::runtime_error);
+  std::filesystem::resize_file(path, 4);
+  EXPECT_THROW(Checkpoint::load(path), std::runtime_error);
+  std::filesystem::remove(path);
+  EXPECT_THROW(Checkpoint::load(path), std::runtime_error);
+}
@@ -0,0 +1,276 @@
+#include "../event_trace.hpp"
+#include "../simulation.hpp"
+#include "workload.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+
+namespace {
+
+std::string tempPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+struct ExpectedEvent {
+  TraceEventType type;
+  unsigned int time;
+  unsigned int pid;
+};
+
+// Every event the kernel reports, including the ones a recorder leaves out
+struct EveryEvent : NullObserver {
+  std::vector<TraceEvent> events;
+
+  void add(TraceEventType type, size_t idx, unsigned int time) {
+    events.push_back({time, static_cast<uint32_t>(type)
+                                    << TraceEvent::indexBits |
+                                static_cast<uint32_t>(idx)});
+  }
+  void onArrival(size_t idx, unsigned int time) {
+    add(TraceEventType::Arrival, idx, time);
+  }
+  void onSlice(size_t idx, unsigned int start, unsigned int) {
+    add(TraceEventType::Dispatch, idx, start);
+  }
+  void onPreempt(size_t idx, unsigned int time) {
+    add(TraceEventType::Preempt, idx, time);
+  }
+  void onComplete(size_t idx, unsigned int time) {
+    add(TraceEventType::Complete, idx, time);
+  }
+};
+
+} // namespace
+
+TEST(TraceRecorderTest, RecordsEverySchedulingEvent) {
+  auto *strategy = new RoundRobinStrategy(3);
+  Scheduler scheduler(strategy);
+  TraceRecorder recorder;
+  strategy->setTraceRecorder(&recorder);
+  scheduler.addProcess({0, 0, 5});
+  scheduler.addProcess({1, 2, 4});
+  scheduler.addProcess({2, 5, 2});
+  scheduler.run();
+
+  using T = TraceEventType;
+  const ExpectedEvent expected[] = {
+      {T::Arrival, 0, 0},   {T::Dispatch, 0, 0},  {T::Arrival, 2, 1},
+      {T::Preempt, 3, 0},   {T::Dispatch, 3, 1},  {T::Arrival, 5, 2},
+      {T::Preempt, 6, 1},   {T::Dispatch, 6, 0},  {T::Complete, 8, 0},
+      {T::Dispatch, 8, 2},  {T::Complete, 10, 2}, {T::Dispatch, 10, 1},
+      {T::Complete, 11, 1},
+  };
+  const auto events = recorder.events();
+  const auto &pids = scheduler.getProcesses().pid;
+  ASSERT_EQ(events.size(), std::size(expected));
+  for (size_t i = 0; i < events.size(); ++i) {
+    EXPECT_EQ(events[i].type(), expected[i].type) << "event " << i;
+    EXPECT_EQ(events[i].time, expected[i].time) << "event " << i;
+    EXPECT_EQ(pids[events[i].index()], expected[i].pid) << "event " << i;
+  }
+}
+
+TEST(TraceRecorderTest, RecordingDoesNotChangeTheSchedule) {
+  std::mt19937 rng(17);
+  // Spread out enough to leave the CPU idle at times
+  const auto procs = randomWorkload(rng, 500, 12000, 40);
+
+  auto *strategy = new RoundRobinStrategy(4);
+  Scheduler traced(strategy);
+  TraceRecorder recorder;
+  strategy->setTraceRecorder(&recorder);
+  traced.addProcesses(procs);
+  traced.run();
+
+  Scheduler plain(new RoundRobinStrategy(4));
+  plain.addProcesses(procs);
+  plain.run();
+
+  // The replayed events are the ones the kernel reported
+  const auto &table = traced.getProcesses();
+  const auto order = sortByArrival(table.startTime);
+  std::vector<unsigned int> remaining(table.burstTime.begin(),
+                                      table.burstTime.end());
+  std::vector<int> end(table.size(), -1);
+  RingBuffer<unsigned int> queue;
+  EveryEvent every;
+  simulateRoundRobin(WorkloadView{table.startTime, table.burstTime, order},
+                     remaining, end, queue, RuntimeQuantum{4}, 0, every);
+  const auto events = recorder.events();
+  ASSERT_EQ(events.size(), every.events.size());
+  for (size_t i = 0; i < events.size(); ++i) {
+    ASSERT_EQ(events[i].word, every.events[i].word) << "event " << i;
+    ASSERT_EQ(events[i].time, every.events[i].time) << "event " << i;
+  }
+  // One stored index per slice
+  const auto slices = std::ranges::count_if(events, [](const TraceEvent &e) {
+    return e.type() == TraceEventType::Dispatch;
+  });
+  EXPECT_EQ(recorder.size(), static_cast<size_t>(slices));
+
+  for (const auto &proc : procs) {
+    EXPECT_EQ(traced.getProcess(proc.pid).endTime,
+              plain.getProcess(proc.pid).endTime);
+  }
+}
+
+TEST(TraceRecorderTest, ReplaysFromTheRunsStartTime) {
+  TraceRecorder recorder;
+  const unsigned int startTime[] = {0, 30};
+  const unsigned int burstTime[] = {2, 1};
+  // A run that begins at 10, then sits idle until the second arrival
+  auto queue = recorder.begin(startTime, burstTime, 4, 10);
+  queue.push_back(0);
+  queue.pop_front();
+  queue.push_back(1);
+  queue.pop_front();
+  recorder.end(queue);
+
+  using T = TraceEventType;
+  const ExpectedEvent expected[] = {
+      {T::Arrival, 0, 0},   {T::Dispatch, 10, 0}, {T::Complete, 12, 0},
+      {T::Arrival, 30, 1},  {T::Dispatch, 30, 1}, {T::Complete, 31, 1},
+  };
+  const auto events = recorder.events();
+  ASSERT_EQ(events.size(), std::size(expected));
+  for (size_t i = 0; i < events.size(); ++i) {
+    EXPECT_EQ(events[i].type(), expected[i].type) << "event " << i;
+    EXPECT_EQ(events[i].time, expected[i].time) << "event " << i;
+    EXPECT_EQ(events[i].index(), expected[i].pid) << "event " << i;
+  }
+
+  recorder.clear();
+  EXPECT_TRUE(recorder.empty());
+  EXPECT_TRUE(recorder.events().empty());
+  EXPECT_THROW(recorder.begin(startTime, burstTime, 0, 0),
+               std::invalid_argument);
+}
+
+TEST(EventLogTest, RoundTrip) {
+  auto *strategy = new RoundRobinStrategy(2);
+  Scheduler scheduler(strategy);
+  TraceRecorder recorder;
+  strategy->setTraceRecorder(&recorder);
+  scheduler.addProcess({40, 0, 3});
+  scheduler.addProcess({41, 1, 2});
+  scheduler.run();
+
+  const auto path = tempPath("rr_event_log_test.bin");
+  writeEventLog(path, recorder, scheduler.getProcesses().pid);
+  const auto log = readEventLog(path);
+  std::filesystem::remove(path);
+
+  const auto &pids = scheduler.getProcesses().pid;
+  EXPECT_TRUE(std::ranges::equal(log.pids, pids));
+  const auto events = recorder.events();
+  ASSERT_EQ(log.events.size(), events.size());
+  for (size_t i = 0; i < events.size(); ++i) {
+    EXPECT_EQ(log.events[i].time, events[i].time);
+    EXPECT_EQ(log.events[i].word, events[i].word);
+  }
+}
+
+TEST(EventLogTest, RejectsCountsTheFileCannotHold) {
+  auto *strategy = new RoundRobinStrategy(2);
+  Scheduler scheduler(strategy);
+  TraceRecorder recorder;
+  strategy->setTraceRecorder(&recorder);
+  scheduler.addProcess({40, 0, 3});
+  scheduler.run();
+
+  const auto path = tempPath("rr_event_log_damaged.bin");
+  writeEventLog(path, recorder, scheduler.getProcesses().pid);
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    EventLogHeader header{};
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    header.sliceCount = uint64_t{1} << 40;
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  }
+  EXPECT_THROW(readEventLog(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(ResultColumnsTest, RoundTrip) {
+  Scheduler scheduler(new RoundRobinStrategy(3));
+  scheduler.addProcess({7, 0, 5});
+  scheduler.addProcess({8, 2, 4});
+  scheduler.addProcess({9, 5, 2});
+  scheduler.run();
+
+  const auto path = tempPath("rr_result_columns_test.bin");
+  writeResultColumns(path, scheduler.getProcesses());
+  const auto procs = readResultColumns(path);
+  std::filesystem::remove(path);
+
+  ASSERT_EQ(procs.size(), 3u);
+  for (const auto &proc : procs) {
+    const auto expected = scheduler.getProcess(proc.pid);
+    EXPECT_EQ(proc.startTime, expected.startTime);
+    EXPECT_EQ(proc.burstTime, expected.burstTime);
+    EXPECT_EQ(proc.endTime, expected.endTime);
+    EXPECT_EQ(proc.waitingTime, expected.waitingTime);
+  }
+}
+
+TEST(ResultColumnsTest, RejectsOtherFiles) {
+  const auto path = tempPath("rr_result_columns_bad.bin");
+  TraceRecorder recorder;
+  writeEventLog(path, recorder, {});
+  EXPECT_THROW(readResultColumns(path), std::runtime_error);
+  EXPECT_TRUE(readEventLog(path).events.empty());
+  const unsigned int pids[] = {1};
+  EXPECT_THROW(writeEventLog(path, recorder, pids), std::invalid_argument);
+  std::filesystem::remove(path);
+}
+
+TEST(ResultColumnsTest, RejectsCountsTheFileCannotHold) {
+  Scheduler scheduler(new RoundRobinStrategy(3));
+  scheduler.addProcess({7, 0, 5});
+  scheduler.addProcess({8, 2, 4});
+  scheduler.run();
+
+  const auto path = tempPath("rr_result_columns_damaged.bin");
+  writeResultColumns(path, scheduler.getProcesses());
+  for (const uint64_t rowCount : {uint64_t{3}, uint64_t{1} << 40}) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    ResultColumnsHeader header{};
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    header.rowCount = rowCount;
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.close();
+    EXPECT_THROW(readResultColumns(path), std::runtime_error);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(ChromeTraceTest, OneCompleteEventPerSlice) {
+  auto *strategy = new RoundRobinStrategy(2);
+  Scheduler scheduler(strategy);
+  TraceRecorder recorder;
+  strategy->setTraceRecorder(&recorder);
+  scheduler.addProcess({5, 0, 3});
+  scheduler.addProcess({6, 0, 1});
+  scheduler.run();
+
+  std::ostringstream out;
+  writeChromeTrace(out, recorder, scheduler.getProcesses().pid);
+  const std::string json = out.str();
+
+  // P5 0-2, P6 2-3, P5 3-4
+  size_t slices = 0;
+  for (size_t pos = json.find("\"ph\": \"X\""); pos != std::string::npos;
+       pos = json.find("\"ph\": \"X\"", pos + 1)) {
+    slices++;
+  }
+  EXPECT_EQ(slices, 3u);
+  EXPECT_NE(json.find(R"("name": "P6", "ph": "X", "pid": 0, "tid": 0, )"
+                      R"("ts": 2, "dur": 1)"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+}
@@ -0,0 +1,213 @@
+#include "../executor.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST(BoundedMpmcQueueTest, FifoUntilFull) {
+  BoundedMpmcQueue<int> queue(4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.try_push(i));
+  }
+  EXPECT_FALSE(queue.try_push(4));
+
+  int value = -1;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(BoundedMpmcQueueTest, RejectsCapacityThatIsNotAPowerOfTwo) {
+  EXPECT_THROW(BoundedMpmcQueue<int>(6), std::invalid_argument);
+}
+
+TEST(BoundedMpmcQueueTest, ConcurrentProducersAndConsumers) {
+  BoundedMpmcQueue<int> queue(64);
+  constexpr int perProducer = 20000;
+  std::atomic<long long> sum{0};
+  std::atomic<int> popped{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < 2; ++p) {
+    threads.emplace_back([&queue] {
+      for (int i = 1; i <= perProducer; ++i) {
+        while (!queue.try_push(i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int c = 0; c < 2; ++c) {
+    threads.emplace_back([&] {
+      int value;
+      while (popped.load() < 2 * perProducer) {
+        if (queue.try_pop(value)) {
+          sum += value;
+          popped++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(sum.load(), 2LL * perProducer * (perProducer + 1) / 2);
+}
+
+static Task countTo(int steps, std::atomic<int> &total) {
+  for (int i = 0; i < steps; ++i) {
+    total++;
+    co_await yieldPoint();
+  }
+}
+
+TEST(RoundRobinExecutorTest, RecordsEveryJob) {
+  std::atomic<int> total{0};
+  RoundRobinExecutor executor(4, 50us);
+  for (unsigned int pid = 0; pid < 2000; ++pid) {
+    executor.submit(pid, countTo(5, total));
+  }
+  executor.wait();
+
+  EXPECT_EQ(total.load(), 10000);
+  const auto results = executor.results();
+  ASSERT_EQ(results.size(), 2000u);
+  std::set<unsigned int> pids;
+  for (const auto &proc : results) {
+    pids.insert(proc.pid);
+    EXPECT_GE(proc.endTime, static_cast<int>(proc.startTime));
+    const int turnaround = proc.endTime - static_cast<int>(proc.startTime);
+    EXPECT_EQ(proc.waitingTime,
+              std::max(0, turnaround - static_cast<int>(proc.burstTime)));
+  }
+  EXPECT_EQ(pids.size(), 2000u);
+}
+
+static Task logSteps(char name, int steps, std::string &log) {
+  for (int i = 0; i < steps; ++i) {
+    log.push_back(name);
+    co_await yieldPoint();
+  }
+}
+
+TEST(RoundRobinExecutorTest, ExpiredQuantumRotatesJobs) {
+  std::string log; // Single worker, so no synchronization is needed
+  {
+    RoundRobinExecutor executor(1, 0us);
+    executor.submit(0, logSteps('a', 50, log));
+    executor.submit(1, logSteps('b', 50, log));
+    executor.wait();
+  }
+
+  // Once both jobs are queued they alternate every step
+  const size_t firstB = log.find('b');
+  const size_t lastA = log.rfind('a');
+  ASSERT_NE(firstB, std::string::npos);
+  for (size_t i = firstB; i + 1 <= lastA; ++i) {
+    EXPECT_NE(log[i], log[i + 1]) << log;
+  }
+}
+
+static Task logAfter(const std::atomic<bool> &go, char name, int steps,
+                     std::string &log) {
+  while (!go) {
+    std::this_thread::yield();
+  }
+  for (int i = 0; i < steps; ++i) {
+    log.push_back(name);
+    co_await yieldPoint();
+  }
+}
+
+TEST(RoundRobinExecutorTest, FullQueueStillRotatesJobs) {
+  std::string log;
+  std::atomic<bool> go{false};
+  {
+    // Room for two jobs, so the third waits for one of them to finish
+    RoundRobinExecutor executor(1, 0us, 2);
+    executor.submit(0, logAfter(go, 'a', 50, log));
+    executor.submit(1, logSteps('b', 50, log));
+    std::thread late([&] { executor.submit(2, logSteps('c', 50, log)); });
+    std::this_thread::sleep_for(10ms);
+    go = true;
+    late.join();
+    executor.wait();
+  }
+
+  ASSERT_EQ(log.size(), 150u);
+  // The queue is full when each slice ends, and the job still goes behind
+  // the one that was waiting rather than straight back on the CPU
+  const size_t firstDone = std::min(log.rfind('a'), log.rfind('b'));
+  ASSERT_LT(log.find('b'), firstDone) << log;
+  for (size_t i = log.find('b'); i < firstDone; ++i) {
+    EXPECT_NE(log[i], log[i + 1]) << log;
+  }
+  EXPECT_GT(log.find('c'), firstDone) << log;
+}
+
+TEST(RoundRobinExecutorTest, SmallQueuesFinishEveryJob) {
+  std::atomic<int> total{0};
+  RoundRobinExecutor executor(4, 0us, 2);
+  for (unsigned int pid = 0; pid < 500; ++pid) {
+    executor.submit(pid, countTo(20, total));
+  }
+  executor.wait();
+  EXPECT_EQ(total.load(), 10000);
+  EXPECT_EQ(executor.results().size(), 500u);
+}
+
+static Task spinFor(std::chrono::milliseconds length) {
+  const auto end = std::chrono::steady_clock::now() + length;
+  while (std::chrono::steady_clock::now() < end) {
+    co_await yieldPoint();
+  }
+}
+
+TEST(RoundRobinExecutorTest, LongJobDoesNotBlockShortOnes) {
+  RoundRobinExecutor executor(1, 200us);
+  executor.submit(0, spinFor(100ms));
+  for (unsigned int pid = 1; pid <= 10; ++pid) {
+    executor.submit(pid, spinFor(0ms));
+  }
+  executor.wait();
+
+  const auto results = executor.results();
+  const auto longJob =
+      std::find_if(results.begin(), results.end(),
+                   [](const Process &proc) { return proc.pid == 0; });
+  ASSERT_NE(longJob, results.end());
+  EXPECT_GE(longJob->endTime - static_cast<int>(longJob->startTime), 100000);
+  for (const auto &proc : results) {
+    if (proc.pid != 0) {
+      EXPECT_LT(proc.endTime, longJob->endTime);
+    }
+  }
+}
+
+static Task failAfterYield() {
+  co_await yieldPoint();
+  throw std::runtime_error("job failed");
+}
+
+TEST(RoundRobinExecutorTest, WaitRethrowsJobException) {
+  RoundRobinExecutor executor(2, 10us);
+  std::atomic<int> total{0};
+  executor.submit(0, failAfterYield());
+  executor.submit(1, countTo(3, total));
+  EXPECT_THROW(executor.wait(), std::runtime_error);
+  EXPECT_EQ(total.load(), 3);
+  EXPECT_EQ(executor.results().size(), 2u);
+}
+
+TEST(RoundRobinExecutorTest, RejectsZeroWorkers) {
+  EXPECT_THROW(RoundRobinExecutor(0, 10us), std::invalid_argument);
+}
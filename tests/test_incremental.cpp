@@ -0,0 +1,134 @@
+#include "../incremental.hpp"
+#include "workload.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+// Compares with a full rerun of `procs` by Scheduler
+void expectMatchesFullRun(const IncrementalRoundRobin &sim,
+                          const std::vector<Process> &procs,
+                          unsigned int quantum) {
+  Scheduler reference(new RoundRobinStrategy(quantum));
+  reference.addProcesses(procs);
+  reference.run();
+  for (const auto &proc : procs) {
+    const auto got = sim.getProcess(proc.pid);
+    const auto want = reference.getProcess(proc.pid);
+    ASSERT_EQ(got.endTime, want.endTime) << "pid " << proc.pid;
+    ASSERT_EQ(got.waitingTime, want.waitingTime) << "pid " << proc.pid;
+  }
+  for (const auto remaining : sim.getProcesses().remainingTime) {
+    ASSERT_EQ(remaining, 0u);
+  }
+  EXPECT_EQ(sim.getCurrentTime(), reference.getCurrentTime());
+}
+
+} // namespace
+
+TEST(IncrementalTest, RunMatchesScheduler) {
+  std::mt19937 rng(1);
+  const auto procs = randomWorkload(rng, 3000, 20000, 30);
+  IncrementalRoundRobin sim(4, 32);
+  sim.addProcesses(procs);
+  sim.run();
+  EXPECT_GT(sim.snapshotCount(), 1u);
+  expectMatchesFullRun(sim, procs, 4);
+}
+
+TEST(IncrementalTest, RandomEditsMatchFullReruns) {
+  // Sparse traces go idle and converge; dense ones keep a long queue
+  for (const unsigned int maxArrival : {60000u, 4000u}) {
+    std::mt19937 workloadRng(maxArrival);
+    auto procs = randomWorkload(workloadRng, 2000, maxArrival, 30);
+    IncrementalRoundRobin sim(3, 16);
+    sim.addProcesses(procs);
+    sim.run();
+
+    std::mt19937 rng(maxArrival + 1);
+    std::uniform_int_distribution<size_t> pick(0, procs.size() - 1);
+    std::uniform_int_distribution<unsigned int> arrival(0, maxArrival);
+    std::uniform_int_distribution<unsigned int> burst(1, 60);
+    for (int edit = 0; edit < 40; ++edit) {
+      auto &proc = procs[pick(rng)];
+      // Alternate burst-only edits with moves earlier or later
+      if (edit % 2 == 0) {
+        proc.startTime = arrival(rng);
+      }
+      proc.burstTime = burst(rng);
+      sim.updateProcess(proc.pid, proc.startTime, proc.burstTime);
+      expectMatchesFullRun(sim, procs, 3);
+    }
+  }
+}
+
+TEST(IncrementalTest, ConvergesAfterAnIdleGap) {
+  // Two bursts of work with an idle gap between them
+  std::vector<Process> procs;
+  for (unsigned int pid = 0; pid < 200; ++pid) {
+    procs.emplace_back(pid, pid, 10);
+    procs.emplace_back(pid + 1000, 100000 + pid, 10);
+  }
+  IncrementalRoundRobin sim(4, 8);
+  sim.addProcesses(procs);
+  sim.run();
+
+  procs[100].burstTime = 25;
+  sim.updateProcess(procs[100].pid, procs[100].startTime, 25);
+  const auto &stats = sim.getLastUpdate();
+  EXPECT_TRUE(stats.converged);
+  EXPECT_LE(stats.stoppedAt, 100000u + 10 * 200);
+  EXPECT_LT(stats.slicesReplayed, 2 * 200 * 3u); // Not the second burst
+  expectMatchesFullRun(sim, procs, 4);
+}
+
+TEST(IncrementalTest, EditResumesFromBeforeTheEarlierArrival) {
+  std::mt19937 rng(7);
+  auto procs = randomWorkload(rng, 1000, 10000, 30);
+  IncrementalRoundRobin sim(2, 8);
+  sim.addProcesses(procs);
+  sim.run();
+
+  // Moved from its old arrival to a much earlier one
+  auto &late = *std::max_element(
+      procs.begin(), procs.end(), [](const Process &a, const Process &b) {
+        return a.startTime < b.startTime;
+      });
+  late.startTime = 50;
+  sim.updateProcess(late.pid, late.startTime, late.burstTime);
+  EXPECT_LT(sim.getLastUpdate().resumedAt, 50u);
+  expectMatchesFullRun(sim, procs, 2);
+
+  // Edits at time 0 replay from the start
+  procs[0].startTime = 0;
+  sim.updateProcess(procs[0].pid, 0, procs[0].burstTime);
+  EXPECT_EQ(sim.getLastUpdate().resumedAt, 0u);
+  expectMatchesFullRun(sim, procs, 2);
+}
+
+TEST(IncrementalTest, UpdatesBeforeRunOrAfterAddingProcesses) {
+  std::mt19937 rng(9);
+  auto procs = randomWorkload(rng, 500, 3000, 30);
+  IncrementalRoundRobin sim(5);
+  sim.addProcesses(procs);
+  procs[3].burstTime = 40;
+  sim.updateProcess(procs[3].pid, procs[3].startTime, 40);
+  sim.run();
+  expectMatchesFullRun(sim, procs, 5);
+
+  procs.emplace_back(9999, 1500, 12);
+  sim.addProcess(procs.back());
+  procs[4].startTime = 2000;
+  sim.updateProcess(procs[4].pid, 2000, procs[4].burstTime);
+  expectMatchesFullRun(sim, procs, 5);
+}
+
+TEST(IncrementalTest, RejectsBadEdits) {
+  IncrementalRoundRobin sim(4);
+  sim.addProcess({1, 0, 5});
+  sim.run();
+  EXPECT_THROW(sim.updateProcess(2, 0, 5), std::out_of_range);
+  EXPECT_THROW(sim.updateProcess(1, 0, 0), std::invalid_argument);
+  EXPECT_THROW(IncrementalRoundRobin(0), std::invalid_argument);
+}
@@ -0,0 +1,123 @@
+#include "../scheduler.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+  LatencyHistogram hist;
+  for (uint64_t value = 1; value <= 100; ++value) {
+    hist.record(value);
+  }
+
+  EXPECT_EQ(hist.count(), 100u);
+  EXPECT_EQ(hist.min(), 1u);
+  EXPECT_EQ(hist.max(), 100u);
+  EXPECT_DOUBLE_EQ(hist.mean(), 50.5);
+  EXPECT_EQ(hist.percentile(0.5), 50u);
+  EXPECT_EQ(hist.percentile(0.99), 99u);
+  EXPECT_EQ(hist.percentile(1.0), 100u);
+}
+
+TEST(LatencyHistogramTest, LargeValuesWithinRelativeError) {
+  for (uint64_t value : {1000ull, 123456ull, 987654321ull, 1ull << 40}) {
+    LatencyHistogram hist;
+    hist.record(value);
+    hist.record(value * 2); // Keeps max() from clamping the percentile
+    const uint64_t reported = hist.percentile(0.5);
+    EXPECT_GE(reported, value);
+    EXPECT_LE(reported - value, value / 64) << value;
+  }
+}
+
+TEST(LatencyHistogramTest, MergeAndReset) {
+  LatencyHistogram a;
+  LatencyHistogram b;
+  a.record(10);
+  b.record(1000);
+  b.record(5);
+  a.merge(b);
+
+  EXPECT_EQ(a.count(), 3u);
+  EXPECT_EQ(a.min(), 5u);
+  EXPECT_EQ(a.max(), 1000u);
+  EXPECT_EQ(a.getSum(), 1015u);
+
+  a.reset();
+  EXPECT_EQ(a.count(), 0u);
+  EXPECT_EQ(a.percentile(0.5), 0u);
+}
+
+TEST(SchedulerMetricsTest, RoundRobinFillsMetrics) {
+  if (!metricsEnabled) {
+    GTEST_SKIP() << "Metrics compiled out";
+  }
+  auto *strategy = new RoundRobinStrategy(3);
+  Scheduler scheduler(strategy);
+  scheduler.addProcess({0, 0, 5});
+  scheduler.addProcess({1, 2, 4});
+  scheduler.addProcess({2, 5, 2});
+  scheduler.run();
+
+  // P0 0-3, P1 3-6, P0 6-8, P2 8-10, P1 10-11
+  const auto &metrics = strategy->getMetrics();
+  EXPECT_EQ(metrics.slices, 5u);
+  EXPECT_EQ(metrics.contextSwitches, 4u);
+  EXPECT_EQ(metrics.idleTime, 0u);
+  EXPECT_EQ(metrics.queueHighWater, 3u);
+  EXPECT_EQ(metrics.waitingTime.count(), 3u);
+  EXPECT_EQ(metrics.waitingTime.getSum(), 3u + 5u + 3u);
+  EXPECT_EQ(metrics.waitingTime.max(), 5u);
+  EXPECT_EQ(metrics.turnaroundTime.max(), 9u);
+  EXPECT_EQ(metrics.sliceLength.getSum(), 11u);
+  EXPECT_GE(metrics.runSeconds, 0.0);
+}
+
+TEST(SchedulerMetricsTest, IdleTimeFromFastForward) {
+  if (!metricsEnabled) {
+    GTEST_SKIP() << "Metrics compiled out";
+  }
+  auto *strategy = new RoundRobinStrategy(4);
+  Scheduler scheduler(strategy);
+  scheduler.addProcess({0, 0, 2});
+  scheduler.addProcess({1, 10, 3});
+  scheduler.run();
+
+  EXPECT_EQ(strategy->getMetrics().idleTime, 8u);
+  EXPECT_EQ(strategy->getMetrics().contextSwitches, 1u);
+}
+
+TEST(SchedulerMetricsTest, MetricsResetBetweenRuns) {
+  if (!metricsEnabled) {
+    GTEST_SKIP() << "Metrics compiled out";
+  }
+  auto *strategy = new RoundRobinStrategy(2);
+  Scheduler scheduler(strategy);
+  scheduler.addProcess({0, 0, 4});
+  scheduler.run();
+  scheduler.reset();
+  scheduler.addProcess({0, 0, 1});
+  scheduler.run();
+
+  EXPECT_EQ(strategy->getMetrics().slices, 1u);
+  EXPECT_EQ(strategy->getMetrics().turnaroundTime.count(), 1u);
+}
+
+TEST(SchedulerMetricsTest, Exports) {
+  SchedulerMetrics metrics;
+  metrics.waitingTime.record(7);
+  metrics.contextSwitches = 12;
+
+  std::ostringstream json;
+  writeMetricsJson(json, metrics);
+  EXPECT_NE(json.str().find("\"waiting_time\": {\"count\": 1"),
+            std::string::npos);
+  EXPECT_NE(json.str().find("\"p99\": 7"), std::string::npos);
+  EXPECT_NE(json.str().find("\"context_switches\": 12"), std::string::npos);
+
+  std::ostringstream prom;
+  writeMetricsPrometheus(prom, metrics, "rr");
+  EXPECT_NE(prom.str().find("# TYPE rr_waiting_time summary"),
+            std::string::npos);
+  EXPECT_NE(prom.str().find("rr_waiting_time{quantile=\"0.99\"} 7"),
+            std::string::npos);
+  EXPECT_NE(prom.str().find("rr_context_switches_total 12"), std::string::npos);
+}
@@ -0,0 +1,103 @@
+#include "../multi_core_strategy.hpp"
+#include "workload.hpp"
+#include <gtest/gtest.h>
+#include <random>
+
+TEST(MultiCoreStrategyTest, SingleCoreMatchesRoundRobin) {
+  std::mt19937 rng(11);
+  for (int round = 0; round < 20; ++round) {
+    const auto procs = randomWorkload(rng, 60, 300, 25);
+    const unsigned int quantum = rng() % 6 + 1;
+    // Every other round starts part way through the arrivals
+    const unsigned int start = round % 2 == 0 ? 0 : rng() % 150 + 1;
+
+    Scheduler single(new RoundRobinStrategy(quantum));
+    single.addProcesses(procs);
+    single.setCurrentTime(start);
+    single.run();
+
+    Scheduler multi(new MultiCoreRoundRobinStrategy(1, quantum));
+    multi.addProcesses(procs);
+    multi.setCurrentTime(start);
+    multi.run();
+
+    for (const auto &proc : procs) {
+      EXPECT_EQ(multi.getProcess(proc.pid).endTime,
+                single.getProcess(proc.pid).endTime);
+      EXPECT_EQ(multi.getProcess(proc.pid).waitingTime,
+                single.getProcess(proc.pid).waitingTime);
+    }
+    EXPECT_EQ(multi.getCurrentTime(), single.getCurrentTime());
+  }
+}
+
+TEST(MultiCoreStrategyTest, CoresRunInParallel) {
+  Scheduler scheduler(new MultiCoreRoundRobinStrategy(2, 4));
+  scheduler.addProcess({0, 0, 6});
+  scheduler.addProcess({1, 0, 3});
+  scheduler.run();
+
+  EXPECT_EQ(scheduler.getProcess(0).endTime, 6);
+  EXPECT_EQ(scheduler.getProcess(1).endTime, 3);
+  EXPECT_EQ(scheduler.getProcess(0).waitingTime, 0);
+  EXPECT_EQ(scheduler.getCurrentTime(), 6u);
+}
+
+TEST(MultiCoreStrategyTest, UtilizationCoversOnlyTheRun) {
+  auto *strategy = new MultiCoreRoundRobinStrategy(2, 4);
+  Scheduler scheduler(strategy);
+  scheduler.addProcess({0, 0, 6});
+  scheduler.addProcess({1, 40, 3});
+  scheduler.setCurrentTime(50);
+  scheduler.run();
+
+  // Both were waiting at 50, so each core is busy from the start
+  EXPECT_EQ(scheduler.getProcess(0).endTime, 56);
+  EXPECT_EQ(scheduler.getProcess(1).endTime, 53);
+  const auto &stats = strategy->getCoreStats();
+  EXPECT_DOUBLE_EQ(stats[0].utilization + stats[1].utilization, 1.5);
+}
+
+TEST(MultiCoreStrategyTest, IdleCoreStealsQueuedWork) {
+  // Cyclic placement puts P0 and P2 on core 0, P1 on core 1
+  auto *withStealing = new MultiCoreRoundRobinStrategy(
+      2, 10, PlacementPolicy::RoundRobin, true);
+  Scheduler stealing(withStealing);
+  Scheduler noStealing(new MultiCoreRoundRobinStrategy(
+      2, 10, PlacementPolicy::RoundRobin, false));
+  for (auto *scheduler : {&stealing, &noStealing}) {
+    scheduler->addProcess({0, 0, 10});
+    scheduler->addProcess({1, 0, 1});
+    scheduler->addProcess({2, 0, 10});
+    scheduler->run();
+  }
+
+  EXPECT_EQ(noStealing.getProcess(2).endTime, 20);
+  EXPECT_EQ(stealing.getProcess(2).endTime, 11); // Core 1 takes it at t=1
+  EXPECT_EQ(withStealing->getCoreStats()[1].steals, 1u);
+  EXPECT_EQ(withStealing->getCoreStats()[1].busyTime, 11u);
+}
+
+TEST(MultiCoreStrategyTest, ManyCoresAccountForAllWork) {
+  std::mt19937 rng(5);
+  const auto procs = randomWorkload(rng, 20000, 50000, 400);
+  auto *strategy = new MultiCoreRoundRobinStrategy(128, 8);
+  Scheduler scheduler(strategy);
+  scheduler.addProcesses(procs);
+  scheduler.run();
+
+  unsigned long long totalBurst = 0;
+  for (const auto &proc : procs) {
+    const auto result = scheduler.getProcess(proc.pid);
+    EXPECT_GE(result.endTime, static_cast<int>(proc.startTime + proc.burstTime));
+    EXPECT_GE(result.waitingTime, 0);
+    totalBurst += proc.burstTime;
+  }
+
+  unsigned long long totalBusy = 0;
+  for (const auto &stats : strategy->getCoreStats()) {
+    totalBusy += stats.busyTime;
+    EXPECT_LE(stats.utilization, 1.0);
+  }
+  EXPECT_EQ(totalBusy, totalBurst);
+}
@@ -0,0 +1,206 @@
+#include "../scheduler.hpp"
+#include "workload.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <random>
+
+static std::unique_ptr<Scheduler> runWith(SchedulerStrategy *strategy,
+                                          const std::vector<Process> &procs) {
+  auto scheduler = std::make_unique<Scheduler>(strategy);
+  scheduler->addProcesses(procs);
+  scheduler->run();
+  return scheduler;
+}
+
+// Tick-by-tick SRTF: the running process keeps the CPU unless a waiting one
+// has strictly less remaining time; ties go to the earlier arrival
+static std::vector<int> referenceSrtfEndTimes(const std::vector<Process> &procs) {
+  std::vector<size_t> order(procs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&procs](size_t a, size_t b) {
+    return procs[a].startTime < procs[b].startTime;
+  });
+
+  std::vector<unsigned int> remaining;
+  for (const auto &proc : procs) {
+    remaining.push_back(proc.burstTime);
+  }
+  std::vector<int> end(procs.size(), -1);
+  std::vector<size_t> waiting; // Arrival ranks
+  size_t next = 0;
+  size_t done = 0;
+  long cur = -1;
+  for (unsigned int time = 0; done < procs.size();) {
+    while (next < order.size() && procs[order[next]].startTime <= time) {
+      waiting.push_back(next++);
+    }
+    auto best = std::min_element(
+        waiting.begin(), waiting.end(), [&](size_t a, size_t b) {
+          return std::make_pair(remaining[order[a]], a) <
+                 std::make_pair(remaining[order[b]], b);
+        });
+    if (best != waiting.end() &&
+        (cur < 0 || remaining[order[*best]] < remaining[order[cur]])) {
+      const size_t picked = *best;
+      waiting.erase(best);
+      if (cur >= 0) {
+        waiting.push_back(cur);
+      }
+      cur = picked;
+    }
+    if (cur < 0) {
+      time++;
+      continue;
+    }
+    remaining[order[cur]]--;
+    time++;
+    if (remaining[order[cur]] == 0) {
+      end[order[cur]] = time;
+      cur = -1;
+      done++;
+    }
+  }
+  return end;
+}
+
+TEST(SRTFStrategyTest, TextbookExample) {
+  const std::vector<Process> procs{{0, 0, 8}, {1, 1, 4}, {2, 2, 9}, {3, 3, 5}};
+  const auto scheduler = runWith(new SRTFStrategy(), procs);
+
+  EXPECT_EQ(scheduler->getProcess(0).endTime, 17);
+  EXPECT_EQ(scheduler->getProcess(1).endTime, 5);
+  EXPECT_EQ(scheduler->getProcess(2).endTime, 26);
+  EXPECT_EQ(scheduler->getProcess(3).endTime, 10);
+  EXPECT_EQ(scheduler->getProcess(0).waitingTime, 9);
+  EXPECT_EQ(scheduler->getProcess(2).waitingTime, 15);
+  EXPECT_EQ(scheduler->getCurrentTime(), 26u);
+}
+
+TEST(SRTFStrategyTest, MatchesTickReference) {
+  std::mt19937 rng(11);
+  for (int round = 0; round < 20; ++round) {
+    const auto procs = randomWorkload(rng, 40, round % 2 ? 300 : 0, 25);
+    const auto scheduler = runWith(new SRTFStrategy(), procs);
+    const auto expected = referenceSrtfEndTimes(procs);
+    for (size_t i = 0; i < procs.size(); ++i) {
+      EXPECT_EQ(scheduler->getProcess(procs[i].pid).endTime, expected[i])
+          << "pid " << procs[i].pid;
+    }
+  }
+}
+
+TEST(MLFQStrategyTest, DemotesAfterFullQuantum) {
+  const std::vector<Process> procs{{0, 0, 7}, {1, 0, 3}};
+  const auto scheduler = runWith(new MLFQStrategy(2, 3, 0), procs);
+
+  // P0 0-2 (L0), P1 2-4 (L0), P0 4-8 (L1), P1 8-9 (L1), P0 9-10 (L2)
+  EXPECT_EQ(scheduler->getProcess(1).endTime, 9);
+  EXPECT_EQ(scheduler->getProcess(0).endTime, 10);
+}
+
+TEST(MLFQStrategyTest, BoostReturnsQueuedProcessesToTopLevel) {
+  const std::vector<Process> procs{{0, 0, 3}, {1, 0, 3}, {2, 2, 1}};
+
+  // Without a boost P0 and P1 finish their second slices at level 1
+  const auto plain = runWith(new MLFQStrategy(1, 2, 0), procs);
+  EXPECT_EQ(plain->getProcess(2).endTime, 3);
+  EXPECT_EQ(plain->getProcess(0).endTime, 5);
+  EXPECT_EQ(plain->getProcess(1).endTime, 7);
+
+  // The boost at t=3 sends both back to level 0 for one more short slice
+  const auto boosted = runWith(new MLFQStrategy(1, 2, 3), procs);
+  EXPECT_EQ(boosted->getProcess(2).endTime, 3);
+  EXPECT_EQ(boosted->getProcess(0).endTime, 6);
+  EXPECT_EQ(boosted->getProcess(1).endTime, 7);
+}
+
+TEST(MLFQStrategyTest, SingleLevelIsRoundRobin) {
+  std::mt19937 rng(5);
+  for (unsigned int quantum : {1u, 3u, 8u}) {
+    const auto procs = randomWorkload(rng, 60, 400, 30);
+    const auto mlfq = runWith(new MLFQStrategy(quantum, 1, 50), procs);
+    const auto rr = runWith(new RoundRobinStrategy(quantum), procs);
+    for (const auto &proc : procs) {
+      EXPECT_EQ(mlfq->getProcess(proc.pid).endTime,
+                rr->getProcess(proc.pid).endTime);
+    }
+  }
+}
+
+TEST(MLFQStrategyTest, RejectsInvalidLevels) {
+  Scheduler scheduler(new MLFQStrategy(4, 0, 0));
+  scheduler.addProcess({0, 0, 3});
+  EXPECT_THROW(scheduler.run(), std::invalid_argument);
+}
+
+TEST(CFSStrategyTest, SliceShrinksWithRunnableCount) {
+  const std::vector<Process> procs{{0, 0, 4}, {1, 0, 4}};
+  const auto scheduler = runWith(new CFSStrategy(6, 1), procs);
+
+  // Two runnable: 3-unit slices. P0 0-3, P1 3-6, P0 6-7, P1 7-8
+  EXPECT_EQ(scheduler->getProcess(0).endTime, 7);
+  EXPECT_EQ(scheduler->getProcess(1).endTime, 8);
+}
+
+TEST(CFSStrategyTest, LateArrivalStartsAtMinimumVruntime) {
+  const std::vector<Process> procs{{0, 0, 10}, {1, 5, 2}};
+  const auto scheduler = runWith(new CFSStrategy(4, 1), procs);
+
+  // P1 joins at P0's virtual runtime, not at zero, so it runs once and P0
+  // resumes right after
+  EXPECT_EQ(scheduler->getProcess(1).endTime, 10);
+  EXPECT_EQ(scheduler->getProcess(1).waitingTime, 3);
+  EXPECT_EQ(scheduler->getProcess(0).endTime, 12);
+}
+
+TEST(CFSStrategyTest, FixedSlicesWithSimultaneousArrivalsAreRoundRobin) {
+  std::mt19937 rng(9);
+  for (unsigned int granularity : {1u, 4u, 9u}) {
+    const auto procs = randomWorkload(rng, 50, 0, 40);
+    // A latency below the granularity makes every slice minGranularity
+    const auto cfs = runWith(new CFSStrategy(0, granularity), procs);
+    const auto rr = runWith(new RoundRobinStrategy(granularity), procs);
+    for (const auto &proc : procs) {
+      EXPECT_EQ(cfs->getProcess(proc.pid).endTime,
+                rr->getProcess(proc.pid).endTime);
+    }
+  }
+}
+
+TEST(SchedulerFactoryTest, BuildsEveryType) {
+  std::mt19937 rng(3);
+  const auto procs = randomWorkload(rng, 100, 500, 20);
+  unsigned int totalBurst = 0;
+  for (const auto &proc : procs) {
+    totalBurst += proc.burstTime;
+  }
+
+  for (auto type : {SchedulerType::RoundRobin, SchedulerType::MLFQ,
+                    SchedulerType::SRTF, SchedulerType::CFS}) {
+    std::unique_ptr<Scheduler> scheduler(SchedulerFactory(type));
+    ASSERT_NE(scheduler, nullptr);
+    scheduler->addProcesses(procs);
+    scheduler->run();
+    for (const auto &proc : procs) {
+      const auto result = scheduler->getProcess(proc.pid);
+      EXPECT_GE(result.endTime, static_cast<int>(proc.startTime + proc.burstTime));
+      EXPECT_GE(result.waitingTime, 0);
+    }
+    EXPECT_GE(scheduler->getCurrentTime(), totalBurst);
+  }
+}
+
+TEST(SchedulerFactoryTest, PassesParameters) {
+  const std::vector<Process> procs{{0, 0, 5}, {1, 0, 5}};
+  SchedulerParams params;
+  params.timeQuantum = 5;
+  std::unique_ptr<Scheduler> scheduler(
+      SchedulerFactory(SchedulerType::RoundRobin, params));
+  scheduler->addProcesses(procs);
+  scheduler->run();
+
+  EXPECT_EQ(scheduler->getProcess(0).endTime, 5);
+  EXPECT_EQ(scheduler->getProcess(1).endTime, 10);
+}
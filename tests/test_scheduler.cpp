@@ -1,5 +1,15 @@
+#include "../multi_core_strategy.hpp"
 #include "../scheduler.hpp"
+#include "heap_allocations.hpp"
+#include "workload.hpp"
+#include <algorithm>
+#include <array>
+#include <deque>
 #include <gtest/gtest.h>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <random>
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -124,6 +134,25 @@ TEST(SchedulerTest, WaitingTimeAccumulation) {
   EXPECT_EQ(scheduler.getProcess(1).waitingTime, 2);
 }
 
+TEST(SchedulerTest, RerunStartsFromTheBeginning) {
+  RoundRobinStrategy strategy(4);
+  Scheduler scheduler(strategy);
+  scheduler.addProcess({0, 0, 3});
+  scheduler.addProcess({1, 0, 3});
+  scheduler.addProcess({2, 0, 3});
+  scheduler.run();
+  EXPECT_EQ(scheduler.getCurrentTime(), 9u);
+
+  // Same schedule as ThreeProcessesRoundRobinOrder
+  strategy.setTimeQuantum(2);
+  scheduler.run();
+  EXPECT_EQ(scheduler.getProcess(0).endTime, 7);
+  EXPECT_EQ(scheduler.getProcess(1).endTime, 8);
+  EXPECT_EQ(scheduler.getProcess(2).endTime, 9);
+  EXPECT_EQ(scheduler.getProcess(2).waitingTime, 6);
+  EXPECT_EQ(scheduler.getCurrentTime(), 9u);
+}
+
 TEST(SchedulerTest, ResetClearsState) {
   Scheduler scheduler(new RoundRobinStrategy(4));
   scheduler.addProcess({0, 0, 2});
@@ -156,3 +185,293 @@ TEST(SchedulerTest, MixedArrivalTimes) {
   EXPECT_EQ(scheduler.getProcess(1).endTime, 11);
   EXPECT_EQ(scheduler.getProcess(2).endTime, 10);
 }
+
+TEST(SchedulerTest, MidSliceArrivalWaitsOnlySinceArrival) {
+  Scheduler scheduler(new RoundRobinStrategy(3));
+  scheduler.addProcess({0, 0, 5});
+  scheduler.addProcess({1, 2, 4}); // Arrives during P0's first slice
+  scheduler.addProcess({2, 5, 2}); // Arrives during P1's first slice
+  scheduler.run();
+
+  EXPECT_EQ(scheduler.getProcess(0).waitingTime, 3);
+  EXPECT_EQ(scheduler.getProcess(1).waitingTime, 5);
+  EXPECT_EQ(scheduler.getProcess(2).waitingTime, 3);
+}
+
+TEST(SchedulerTest, RunKeepsOriginalBurstTime) {
+  Scheduler scheduler(new RoundRobinStrategy(2));
+  scheduler.addProcess({0, 0, 5});
+  scheduler.addProcess({1, 1, 3});
+  scheduler.run();
+
+  EXPECT_EQ(scheduler.getProcess(0).burstTime, 5u);
+  EXPECT_EQ(scheduler.getProcess(1).burstTime, 3u);
+  EXPECT_EQ(scheduler.getProcesses().remainingTime[0], 0u);
+}
+
+// Reference implementation of the original tick-by-tick simulation. The
+// event-driven engine must reproduce its results exactly.
+static std::vector<Process> referenceTickSchedule(std::vector<Process> procs,
+                                                  unsigned int quantum) {
+  std::vector<size_t> order(procs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&procs](size_t a, size_t b) {
+    return procs[a].startTime < procs[b].startTime;
+  });
+
+  const auto original = procs;
+  std::deque<size_t> queue;
+  unsigned int time = 0;
+  size_t next = 0;
+  while (!queue.empty() || next < order.size()) {
+    while (next < order.size() && procs[order[next]].startTime <= time) {
+      queue.push_back(order[next++]);
+    }
+    if (queue.empty()) {
+      time = procs[order[next]].startTime;
+      continue;
+    }
+
+    const size_t cur = queue.front();
+    queue.pop_front();
+    for (size_t dt = 1; dt <= quantum && procs[cur].burstTime > 0; ++dt) {
+      procs[cur].burstTime--;
+      time++;
+      while (next < order.size() && procs[order[next]].startTime <= time) {
+        queue.push_back(order[next++]);
+      }
+    }
+
+    if (procs[cur].burstTime > 0) {
+      queue.push_back(cur);
+    } else {
+      procs[cur].endTime = time;
+    }
+  }
+
+  // A process is either running or waiting between arrival and completion
+  for (size_t i = 0; i < procs.size(); ++i) {
+    procs[i].waitingTime = procs[i].endTime - original[i].startTime -
+                           original[i].burstTime;
+  }
+  return procs;
+}
+
+static void expectMatchesReference(const std::vector<Process> &procs,
+                                   unsigned int quantum) {
+  Scheduler scheduler(new RoundRobinStrategy(quantum));
+  scheduler.addProcesses(procs);
+  scheduler.run();
+
+  const auto expected = referenceTickSchedule(procs, quantum);
+  for (const auto &ref : expected) {
+    const auto &proc = scheduler.getProcess(ref.pid);
+    EXPECT_EQ(proc.endTime, ref.endTime) << "pid " << ref.pid;
+    EXPECT_EQ(proc.waitingTime, ref.waitingTime) << "pid " << ref.pid;
+  }
+}
+
+TEST(EventDrivenRegressionTest, SimultaneousArrivals) {
+  std::mt19937 rng(1);
+  for (unsigned int quantum : {1u, 2u, 3u, 7u}) {
+    expectMatchesReference(randomWorkload(rng, 20, 0, 15), quantum);
+  }
+}
+
+TEST(EventDrivenRegressionTest, RandomArrivalsMatchTickLoop) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<unsigned int> quantum(1, 10);
+  for (int round = 0; round < 25; ++round) {
+    expectMatchesReference(randomWorkload(rng, 40, 200, 20), quantum(rng));
+  }
+}
+
+TEST(EventDrivenRegressionTest, SparseArrivalsWithIdleGaps) {
+  std::mt19937 rng(7);
+  for (unsigned int quantum : {1u, 4u, 16u}) {
+    expectMatchesReference(randomWorkload(rng, 15, 5000, 30), quantum);
+  }
+}
+
+TEST(EventDrivenRegressionTest, LongBurstsFinishWithoutTicking) {
+  Scheduler scheduler(new RoundRobinStrategy(1000));
+  scheduler.addProcess({0, 0, 2000000000u});
+  scheduler.addProcess({1, 1500, 1000000}); // Arrives during P0's 2nd slice
+  scheduler.run();
+
+  // P1 alternates with P0 from t=2000 until its 1000th slice ends
+  EXPECT_EQ(scheduler.getProcess(1).endTime, 2001000);
+  EXPECT_EQ(scheduler.getProcess(0).endTime, 2001000000);
+  EXPECT_EQ(scheduler.getProcess(0).waitingTime, 1000000);
+  EXPECT_EQ(scheduler.getCurrentTime(), 2001000000u);
+}
+
+// Allocations made by run() for a workload of `count` processes
+static size_t countRunAllocations(size_t count) {
+  std::mt19937 rng(count);
+  Scheduler scheduler(new RoundRobinStrategy(3));
+  scheduler.addProcesses(randomWorkload(rng, count, count * 2, 20));
+
+  const size_t before = heapAllocations();
+  scheduler.run();
+  return heapAllocations() - before;
+}
+
+TEST(SchedulerTest, RunDoesNotAllocateInsideTheSchedulingLoop) {
+  // Only fixed per-run setup may allocate, however many slices are executed
+  EXPECT_EQ(countRunAllocations(10), countRunAllocations(5000));
+}
+
+TEST(SchedulerTest, RerunWithAnotherQuantumDoesNotAllocate) {
+  std::mt19937 rng(5);
+  const auto procs = randomWorkload(rng, 2000, 4000, 20);
+  RoundRobinStrategy strategy(3);
+  Scheduler scheduler(strategy);
+  scheduler.addProcesses(procs);
+  scheduler.run();
+  EXPECT_GT(scheduler.getLastRunAllocations(), 0u);
+
+  const size_t before = heapAllocations();
+  strategy.setTimeQuantum(7);
+  scheduler.run();
+  EXPECT_EQ(heapAllocations() - before, 0u);
+  EXPECT_EQ(scheduler.getLastRunAllocations(), 0u);
+
+  Scheduler fresh(new RoundRobinStrategy(7));
+  fresh.addProcesses(procs);
+  fresh.run();
+  for (const auto &proc : procs) {
+    EXPECT_EQ(scheduler.getProcess(proc.pid).endTime,
+              fresh.getProcess(proc.pid).endTime);
+  }
+}
+
+TEST(SchedulerTest, EveryStrategyReruns) {
+  std::mt19937 rng(9);
+  const auto procs = randomWorkload(rng, 300, 2000, 20);
+  std::vector<std::unique_ptr<SchedulerStrategy>> strategies;
+  strategies.push_back(std::make_unique<RoundRobinStrategy>(3));
+  strategies.push_back(std::make_unique<MLFQStrategy>(2, 4, 100));
+  strategies.push_back(std::make_unique<SRTFStrategy>());
+  strategies.push_back(std::make_unique<CFSStrategy>(12, 2));
+  strategies.push_back(std::make_unique<MultiCoreRoundRobinStrategy>(3, 4));
+  for (auto &strategy : strategies) {
+    Scheduler scheduler(*strategy);
+    scheduler.setCurrentTime(50); // Reruns start here too
+    scheduler.addProcesses(procs);
+    scheduler.run();
+    const auto firstEnd = scheduler.getCurrentTime();
+    std::vector<Process> first;
+    for (const auto &proc : procs) {
+      first.push_back(scheduler.getProcess(proc.pid));
+    }
+
+    scheduler.run();
+    EXPECT_EQ(scheduler.getCurrentTime(), firstEnd);
+    for (const auto &proc : first) {
+      EXPECT_EQ(scheduler.getProcess(proc.pid).endTime, proc.endTime);
+      EXPECT_EQ(scheduler.getProcess(proc.pid).waitingTime, proc.waitingTime);
+    }
+  }
+}
+
+TEST(SchedulerTest, StorageComesFromTheUpstreamResource) {
+  std::mt19937 rng(6);
+  const auto procs = randomWorkload(rng, 100, 200, 10);
+  // Nothing may fall through to the heap once the buffer is used up
+  std::array<std::byte, 1 << 16> buffer;
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                            std::pmr::null_memory_resource());
+  RoundRobinStrategy strategy(4);
+  Scheduler scheduler(strategy, &arena);
+
+  const size_t before = heapAllocations();
+  scheduler.addProcesses(procs);
+  scheduler.run();
+  EXPECT_EQ(heapAllocations() - before, 0u);
+  EXPECT_GT(scheduler.getAllocationCount(), 0u);
+
+  Scheduler reference(new RoundRobinStrategy(4));
+  reference.addProcesses(procs);
+  reference.run();
+  for (const auto &proc : procs) {
+    EXPECT_EQ(scheduler.getProcess(proc.pid).endTime,
+              reference.getProcess(proc.pid).endTime);
+  }
+}
+
+TEST(SchedulerTest, LastRunAllocationsCountKernelScratch) {
+  std::mt19937 rng(7);
+  const auto procs = randomWorkload(rng, 500, 1000, 30);
+  MLFQStrategy strategy(2, 3, 100);
+  Scheduler scheduler(strategy);
+  scheduler.addProcesses(procs);
+  scheduler.run();
+
+  // The feedback queues are built per run, from the scheduler's resource
+  scheduler.reset();
+  scheduler.addProcesses(procs);
+  const size_t before = heapAllocations();
+  scheduler.run();
+  EXPECT_GT(scheduler.getLastRunAllocations(), 0u);
+  EXPECT_EQ(scheduler.getLastRunAllocations(), heapAllocations() - before);
+}
+
+TEST(SchedulerTest, PidLookupAfterManyInsertions) {
+  Scheduler scheduler(new RoundRobinStrategy(2));
+  for (unsigned int pid = 0; pid < 1000; ++pid) {
+    scheduler.addProcess({pid * 7919, pid, 1});
+  }
+  scheduler.run();
+
+  EXPECT_EQ(scheduler.getProcess(999 * 7919).startTime, 999u);
+  EXPECT_EQ(scheduler.getProcess(0).endTime, 1);
+  EXPECT_THROW(scheduler.getProcess(1), std::out_of_range);
+}
+
+TEST(SchedulerTest, PidLookupWithStridedPids) {
+  // PIDs that differ only in their high bits must still spread out
+  for (const unsigned int stride : {1024u, 65536u}) {
+    FlatPidMap map;
+    for (unsigned int i = 0; i < 20000; ++i) {
+      map.insert_or_assign(i * stride, static_cast<int>(i));
+    }
+    EXPECT_LT(map.longestCluster(), 64u) << "stride " << stride;
+    for (unsigned int i = 0; i < 20000; ++i) {
+      const int *index = map.find(i * stride);
+      ASSERT_NE(index, nullptr);
+      EXPECT_EQ(*index, static_cast<int>(i));
+    }
+    EXPECT_EQ(map.find(stride / 2), nullptr);
+  }
+
+  Scheduler scheduler(new RoundRobinStrategy(2));
+  for (unsigned int host = 0; host < 64; ++host) {
+    for (unsigned int n = 0; n < 64; ++n) {
+      scheduler.addProcess({host << 16 | n, host, 1});
+    }
+  }
+  scheduler.run();
+  EXPECT_EQ(scheduler.getProcess(63u << 16 | 63).startTime, 63u);
+  EXPECT_THROW(scheduler.getProcess(64u << 16), std::out_of_range);
+}
+
+TEST(SchedulerTest, AddProcessesMatchesAddProcess) {
+  const std::vector<Process> procs = {{0, 0, 5}, {1, 2, 4}, {2, 5, 0}, {3, 5, 2}};
+  Scheduler bulk(new RoundRobinStrategy(3));
+  bulk.addProcesses(std::span<const Process>(procs).first(2));
+  bulk.addProcesses(std::span<const Process>(procs).subspan(2));
+  bulk.run();
+
+  Scheduler single(new RoundRobinStrategy(3));
+  for (const auto &proc : procs) {
+    single.addProcess(proc);
+  }
+  single.run();
+
+  EXPECT_EQ(bulk.getProcesses().size(), 3u); // Zero-burst pid 2 dropped
+  EXPECT_THROW(bulk.getProcess(2), std::out_of_range);
+  for (unsigned int pid : {0u, 1u, 3u}) {
+    EXPECT_EQ(bulk.getProcess(pid).endTime, single.getProcess(pid).endTime);
+  }
+}
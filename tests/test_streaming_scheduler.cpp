@@ -0,0 +1,113 @@
+#include "../streaming_scheduler.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+
+// Runs a workload through the batch scheduler and returns results by PID
+static std::unordered_map<unsigned int, Process>
+batchResults(const std::vector<Process> &procs, unsigned int quantum) {
+  Scheduler scheduler(new RoundRobinStrategy(quantum));
+  scheduler.addProcesses(procs);
+  scheduler.run();
+
+  std::unordered_map<unsigned int, Process> results;
+  for (const auto &proc : procs) {
+    results.emplace(proc.pid, scheduler.getProcess(proc.pid));
+  }
+  return results;
+}
+
+TEST(StreamingSchedulerTest, MixedArrivalTimes) {
+  StreamingScheduler scheduler(3);
+  scheduler.submit({0, 0, 5});
+  scheduler.submit({1, 2, 4});
+  scheduler.advanceTo(4);
+
+  // Only P0's first slice (0-3) fits before t=4
+  EXPECT_EQ(scheduler.getCurrentTime(), 3u);
+  EXPECT_TRUE(scheduler.drainCompleted().empty());
+
+  scheduler.submit({2, 5, 2});
+  scheduler.finish();
+
+  auto done = scheduler.drainCompleted();
+  ASSERT_EQ(done.size(), 3u);
+  EXPECT_EQ(done[0].pid, 0u);
+  EXPECT_EQ(done[0].endTime, 8);
+  EXPECT_EQ(done[1].pid, 2u);
+  EXPECT_EQ(done[1].endTime, 10);
+  EXPECT_EQ(done[2].pid, 1u);
+  EXPECT_EQ(done[2].endTime, 11);
+  EXPECT_EQ(done[2].waitingTime, 5);
+  EXPECT_EQ(scheduler.liveProcesses(), 0u);
+}
+
+TEST(StreamingSchedulerTest, MatchesBatchSchedulerOnRandomStreams) {
+  std::mt19937 rng(3);
+  for (int round = 0; round < 20; ++round) {
+    std::uniform_int_distribution<unsigned int> gap(0, 6);
+    std::uniform_int_distribution<unsigned int> burst(1, 20);
+    std::vector<Process> procs;
+    unsigned int arrival = 0;
+    for (unsigned int pid = 0; pid < 200; ++pid) {
+      arrival += gap(rng);
+      procs.emplace_back(pid, arrival, burst(rng));
+    }
+    const unsigned int quantum = rng() % 8 + 1;
+    const auto expected = batchResults(procs, quantum);
+
+    // Feed the stream in chunks, advancing to just before the next arrival
+    StreamingScheduler scheduler(quantum);
+    std::vector<Process> done;
+    size_t next = 0;
+    while (next < procs.size()) {
+      const size_t chunk = std::min<size_t>(rng() % 10 + 1, procs.size() - next);
+      const unsigned int upTo = procs[next + chunk - 1].startTime;
+      while (next < procs.size() && procs[next].startTime <= upTo) {
+        scheduler.submit(procs[next++]);
+      }
+      scheduler.advanceTo(upTo);
+      for (auto &proc : scheduler.drainCompleted()) {
+        done.push_back(proc);
+      }
+    }
+    scheduler.finish();
+    for (auto &proc : scheduler.drainCompleted()) {
+      done.push_back(proc);
+    }
+
+    ASSERT_EQ(done.size(), procs.size());
+    for (const auto &proc : done) {
+      EXPECT_EQ(proc.endTime, expected.at(proc.pid).endTime);
+      EXPECT_EQ(proc.waitingTime, expected.at(proc.pid).waitingTime);
+      EXPECT_EQ(proc.burstTime, expected.at(proc.pid).burstTime);
+    }
+  }
+}
+
+TEST(StreamingSchedulerTest, StorageTracksLiveProcesses) {
+  // A long stream where only a handful of processes are ever alive at once
+  StreamingScheduler scheduler(4);
+  size_t completed = 0;
+  for (unsigned int pid = 0; pid < 100000; ++pid) {
+    scheduler.submit({pid, pid * 10, 6});
+    scheduler.advanceTo(pid * 10);
+    completed += scheduler.drainCompleted().size();
+    EXPECT_LE(scheduler.liveProcesses(), 2u);
+  }
+  scheduler.finish();
+  completed += scheduler.drainCompleted().size();
+  EXPECT_EQ(completed, 100000u);
+}
+
+TEST(StreamingSchedulerTest, RejectsArrivalsInThePast) {
+  StreamingScheduler scheduler(4);
+  scheduler.submit({0, 5, 3});
+  EXPECT_THROW(scheduler.submit({1, 4, 3}), std::invalid_argument);
+
+  scheduler.advanceTo(10);
+  EXPECT_THROW(scheduler.submit({2, 10, 3}), std::invalid_argument);
+  EXPECT_THROW(scheduler.advanceTo(9), std::invalid_argument);
+  EXPECT_NO_THROW(scheduler.submit({3, 11, 3}));
+}
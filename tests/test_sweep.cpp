@@ -0,0 +1,69 @@
+#include "../sweep.hpp"
+#include "workload.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+
+// Includes some zero bursts
+static std::vector<Process> sweepWorkload(size_t count) {
+  std::mt19937 rng(17);
+  return randomWorkload(rng, count, count * 4, 30, 0);
+}
+
+TEST(SweepTest, MatchesIndividualSchedulerRuns) {
+  const auto procs = sweepWorkload(500);
+  const Workload workload(procs);
+  const SchedulerType types[] = {SchedulerType::RoundRobin};
+  const unsigned int quanta[] = {1, 2, 5, 16};
+  const auto points = makeSweepGrid(types, quanta);
+  const auto results = runSweep(workload, points, 3);
+
+  ASSERT_EQ(results.size(), 4u);
+  for (size_t i = 0; i < results.size(); ++i) {
+    Scheduler scheduler(new RoundRobinStrategy(quanta[i]));
+    scheduler.addProcesses(procs);
+    scheduler.run();
+
+    const auto &table = scheduler.getProcesses();
+    std::vector<int> waits(table.waitingTime.begin(), table.waitingTime.end());
+    double sum = 0;
+    for (const auto wait : waits) {
+      sum += wait;
+    }
+    std::sort(waits.begin(), waits.end());
+
+    EXPECT_EQ(results[i].point.timeQuantum, quanta[i]);
+    EXPECT_DOUBLE_EQ(results[i].meanWaitingTime, sum / waits.size());
+    EXPECT_EQ(results[i].p99WaitingTime,
+              static_cast<unsigned int>(waits[(waits.size() * 99 + 99) / 100 - 1]));
+    EXPECT_EQ(results[i].makespan, scheduler.getCurrentTime());
+  }
+}
+
+TEST(SweepTest, ThreadCountDoesNotChangeResults) {
+  const Workload workload(sweepWorkload(300));
+  const SchedulerType types[] = {SchedulerType::RoundRobin};
+  std::vector<unsigned int> quanta;
+  for (unsigned int q = 1; q <= 20; ++q) {
+    quanta.push_back(q);
+  }
+  const auto points = makeSweepGrid(types, quanta);
+
+  const auto serial = runSweep(workload, points, 1);
+  const auto parallel = runSweep(workload, points, 8);
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (size_t i = 0; i < serial.size(); ++i) {
+    EXPECT_EQ(serial[i].point.timeQuantum, parallel[i].point.timeQuantum);
+    EXPECT_DOUBLE_EQ(serial[i].meanTurnaroundTime,
+                     parallel[i].meanTurnaroundTime);
+    EXPECT_EQ(serial[i].p99TurnaroundTime, parallel[i].p99TurnaroundTime);
+    EXPECT_EQ(serial[i].makespan, parallel[i].makespan);
+  }
+}
+
+TEST(SweepTest, WorkloadDropsZeroBurstProcesses) {
+  const std::vector<Process> procs = {{0, 0, 5}, {1, 2, 0}, {2, 5, 2}};
+  const Workload workload(procs);
+  EXPECT_EQ(workload.size(), 2u);
+  EXPECT_EQ(workload.view().arrivalOrder.size(), 2u);
+}
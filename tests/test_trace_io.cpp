@@ -0,0 +1,118 @@
+#include "../trace_io.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <vector>
+
+static std::string tempPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static std::vector<Process> readAll(const std::string &path) {
+  std::vector<Process> procs;
+  auto sink = [&procs](std::span<const Process> batch) {
+    procs.insert(procs.end(), batch.begin(), batch.end());
+  };
+  if (detectTraceFormat(path) == TraceFormat::Binary) {
+    readBinaryTrace(path, sink);
+  } else {
+    readCsvTrace(path, sink);
+  }
+  return procs;
+}
+
+static void expectSameTrace(const std::vector<Process> &a,
+                            const std::vector<Process> &b) {
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    EXPECT_EQ(a[i].pid, b[i].pid);
+    EXPECT_EQ(a[i].startTime, b[i].startTime);
+    EXPECT_EQ(a[i].burstTime, b[i].burstTime);
+  }
+}
+
+TEST(TraceIOTest, BinaryRoundTrip) {
+  std::vector<Process> procs;
+  for (unsigned int pid = 0; pid < 10000; ++pid) {
+    procs.emplace_back(pid, pid * 3, pid % 17 + 1);
+  }
+  const auto path = tempPath("rr_trace_roundtrip.bin");
+  writeBinaryTrace(path, procs);
+
+  EXPECT_EQ(detectTraceFormat(path), TraceFormat::Binary);
+  expectSameTrace(readAll(path), procs);
+  std::remove(path.c_str());
+}
+
+TEST(TraceIOTest, CsvRoundTripAcrossReadBuffers) {
+  // Enough lines to span several internal read buffers
+  std::vector<Process> procs;
+  for (unsigned int pid = 0; pid < 200000; ++pid) {
+    procs.emplace_back(pid, 4000000000u - pid, pid % 9 + 1);
+  }
+  const auto path = tempPath("rr_trace_roundtrip.csv");
+  writeCsvTrace(path, procs);
+
+  EXPECT_EQ(detectTraceFormat(path), TraceFormat::Csv);
+  expectSameTrace(readAll(path), procs);
+  std::remove(path.c_str());
+}
+
+TEST(TraceIOTest, CsvSkipsHeaderCommentsAndBlankLines) {
+  const auto path = tempPath("rr_trace_comments.csv");
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "pid,arrival,burst\r\n# comment\r\n\r\n0, 0, 5\r\n1,2 ,4\r\n2,5,2";
+  }
+
+  const auto procs = readAll(path);
+  ASSERT_EQ(procs.size(), 3u);
+  EXPECT_EQ(procs[1].startTime, 2u);
+  EXPECT_EQ(procs[2].burstTime, 2u);
+  std::remove(path.c_str());
+}
+
+TEST(TraceIOTest, MalformedCsvThrows) {
+  const auto path = tempPath("rr_trace_bad.csv");
+  {
+    std::ofstream out(path);
+    out << "0,0,5\n1,x,4\n";
+  }
+  EXPECT_THROW(readAll(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(TraceIOTest, TruncatedBinaryThrows) {
+  const std::vector<Process> procs = {{0, 0, 5}, {1, 2, 4}};
+  const auto path = tempPath("rr_trace_truncated.bin");
+  writeBinaryTrace(path, procs);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+  EXPECT_THROW(readAll(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(TraceIOTest, MissingFileThrows) {
+  Scheduler scheduler(new RoundRobinStrategy(4));
+  EXPECT_THROW(loadBinaryTrace(tempPath("rr_no_such_trace.bin"), scheduler),
+               std::runtime_error);
+}
+
+TEST(TraceIOTest, LoadedTraceSchedulesLikeAddProcess) {
+  const std::vector<Process> procs = {{0, 0, 5}, {1, 2, 4}, {2, 5, 2}, {3, 1, 0}};
+  const auto path = tempPath("rr_trace_load.bin");
+  writeBinaryTrace(path, procs);
+
+  Scheduler scheduler(new RoundRobinStrategy(3));
+  EXPECT_EQ(loadBinaryTrace(path, scheduler), 4u);
+  scheduler.run();
+
+  // Zero-burst processes are dropped just like with addProcess
+  EXPECT_EQ(scheduler.getProcesses().size(), 3u);
+  EXPECT_EQ(scheduler.getProcess(0).endTime, 8);
+  EXPECT_EQ(scheduler.getProcess(1).endTime, 11);
+  EXPECT_EQ(scheduler.getProcess(2).endTime, 10);
+  EXPECT_THROW(scheduler.getProcess(3), std::out_of_range);
+  std::remove(path.c_str());
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../scheduler.hpp"
+#include <random>
+#include <vector>
+
+// Random workload shared by the tests: PIDs 0 to count - 1 in order, arrivals
+// uniform in [0, maxArrival] and bursts uniform in [minBurst, maxBurst], drawn
+// arrival first for each process. Pass minBurst = 0 to include processes the
+// scheduler ignores.
+inline std::vector<Process> randomWorkload(std::mt19937 &rng, size_t count,
+                                           unsigned int maxArrival,
+                                           unsigned int maxBurst,
+                                           unsigned int minBurst = 1) {
+  std::uniform_int_distribution<unsigned int> arrival(0, maxArrival);
+  std::uniform_int_distribution<unsigned int> burst(minBurst, maxBurst);
+  std::vector<Process> procs;
+  procs.reserve(count);
+  for (unsigned int pid = 0; pid < count; ++pid) {
+    // Separate statements, so the draws happen in a fixed order
+    const unsigned int start = arrival(rng);
+    procs.emplace_back(pid, start, burst(rng));
+  }
+  return procs;
+}
@@ -0,0 +1,48 @@
+#include "../trace_io.hpp"
+#include <cstring>
+#include <iostream>
+
+// Converts a trace between the CSV and binary formats. The input format is
+// detected from the file contents; the output format is the other one unless
+// given explicitly.
+int main(int argc, char **argv) {
+  if (argc < 3 || argc > 4) {
+    std::cerr << "Usage: " << argv[0] << " <input> <output> [--csv|--binary]\n";
+    return 1;
+  }
+
+  try {
+    const std::string input = argv[1];
+    const std::string output = argv[2];
+    const TraceFormat inFormat = detectTraceFormat(input);
+
+    TraceFormat outFormat = inFormat == TraceFormat::Binary
+                                ? TraceFormat::Csv
+                                : TraceFormat::Binary;
+    if (argc == 4) {
+      if (std::strcmp(argv[3], "--csv") == 0) {
+        outFormat = TraceFormat::Csv;
+      } else if (std::strcmp(argv[3], "--binary") == 0) {
+        outFormat = TraceFormat::Binary;
+      } else {
+        std::cerr << "Unknown option " << argv[3] << "\n";
+        return 1;
+      }
+    }
+
+    TraceWriter writer(output, outFormat);
+    auto sink = [&writer](std::span<const Process> batch) {
+      writer.write(batch);
+    };
+    const size_t count = inFormat == TraceFormat::Binary
+                             ? readBinaryTrace(input, sink)
+                             : readCsvTrace(input, sink);
+    writer.close();
+
+    std::cout << "Converted " << count << " processes\n";
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,261 @@
+#include "trace_io.hpp"
+#include "mapped_file.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr char kTraceMagic[8] = {'R', 'R', 'T', 'R', 'A', 'C', 'E', '\0'};
+constexpr uint32_t kTraceVersion = 1;
+constexpr size_t kBatchSize = 4096;
+constexpr size_t kReadBufferSize = 1 << 20;
+
+// Parses one unsigned field and the separator after it
+const char *parseField(const char *first, const char *last, unsigned int &out) {
+  while (first < last && (*first == ' ' || *first == '\t')) {
+    ++first;
+  }
+  auto [ptr, ec] = std::from_chars(first, last, out);
+  if (ec != std::errc()) {
+    return nullptr;
+  }
+  while (ptr < last && (*ptr == ' ' || *ptr == '\t')) {
+    ++ptr;
+  }
+  return ptr;
+}
+
+// Parses `pid,startTime,burstTime` from one line without its newline
+bool parseCsvLine(const char *first, const char *last, Process &out) {
+  unsigned int fields[3];
+  for (int i = 0; i < 3; ++i) {
+    first = parseField(first, last, fields[i]);
+    if (first == nullptr) {
+      return false;
+    }
+    if (i < 2) {
+      if (first == last || *first != ',') {
+        return false;
+      }
+      ++first;
+    }
+  }
+  if (first != last) {
+    return false;
+  }
+
+  out = Process(fields[0], fields[1], fields[2]);
+  return true;
+}
+
+} // namespace
+
+size_t readBinaryTrace(const std::string &path, const TraceSink &sink) {
+  MappedFile file(path);
+  if (file.size() < sizeof(TraceHeader)) {
+    throw std::runtime_error("Trace file too small for header: " + path);
+  }
+
+  TraceHeader header;
+  std::memcpy(&header, file.bytes(), sizeof(header));
+  if (std::memcmp(header.magic, kTraceMagic, sizeof(kTraceMagic)) != 0 ||
+      header.version != kTraceVersion ||
+      header.recordSize != sizeof(TraceRecord)) {
+    throw std::runtime_error("Not a binary trace file: " + path);
+  }
+  if ((file.size() - sizeof(TraceHeader)) / sizeof(TraceRecord) <
+      header.count) {
+    throw std::runtime_error("Binary trace file is truncated: " + path);
+  }
+
+  const char *records = file.bytes() + sizeof(TraceHeader);
+  std::vector<Process> batch;
+  batch.reserve(kBatchSize);
+  for (uint64_t i = 0; i < header.count; ++i) {
+    TraceRecord rec;
+    std::memcpy(&rec, records + i * sizeof(TraceRecord), sizeof(rec));
+    batch.emplace_back(rec.pid, rec.startTime, rec.burstTime);
+    if (batch.size() == kBatchSize) {
+      sink(batch);
+      batch.clear();
+    }
+  }
+  if (!batch.empty()) {
+    sink(batch);
+  }
+  return header.count;
+}
+
+size_t readCsvTrace(const std::string &path, const TraceSink &sink) {
+  FileHandle file(path);
+  std::vector<char> buffer(kReadBufferSize);
+  std::vector<Process> batch;
+  batch.reserve(kBatchSize);
+
+  size_t pending = 0; // Bytes of an incomplete line kept from the last read
+  size_t lineNo = 0;
+  size_t parsed = 0;
+  bool eof = false;
+
+  auto handleLine = [&](const char *first, const char *last) {
+    lineNo++;
+    if (last > first && last[-1] == '\r') {
+      --last;
+    }
+    if (first == last || *first == '#') {
+      return;
+    }
+
+    Process proc(0, 0, 0);
+    if (!parseCsvLine(first, last, proc)) {
+      // Tolerate a header row, nothing else
+      if (lineNo == 1) {
+        return;
+      }
+      throw std::runtime_error("Malformed trace line " +
+                               std::to_string(lineNo) + " in " + path);
+    }
+    batch.push_back(proc);
+    parsed++;
+    if (batch.size() == kBatchSize) {
+      sink(batch);
+      batch.clear();
+    }
+  };
+
+  while (!eof) {
+    if (pending == buffer.size()) {
+      // A single line longer than the buffer
+      buffer.resize(buffer.size() * 2);
+    }
+    const ssize_t got = ::read(file.get(), buffer.data() + pending,
+                               buffer.size() - pending);
+    if (got < 0) {
+      throw std::runtime_error("Error reading trace file: " + path);
+    }
+    eof = got == 0;
+
+    const char *first = buffer.data();
+    const char *last = buffer.data() + pending + got;
+    while (true) {
+      const char *newline =
+          static_cast<const char *>(std::memchr(first, '\n', last - first));
+      if (newline == nullptr) {
+        break;
+      }
+      handleLine(first, newline);
+      first = newline + 1;
+    }
+
+    pending = last - first;
+    if (eof && pending > 0) {
+      handleLine(first, last);
+      pending = 0;
+    }
+    std::memmove(buffer.data(), first, pending);
+  }
+
+  if (!batch.empty()) {
+    sink(batch);
+  }
+  return parsed;
+}
+
+size_t loadBinaryTrace(const std::string &path, Scheduler &scheduler) {
+  return readBinaryTrace(path, [&scheduler](std::span<const Process> batch) {
+    scheduler.addProcesses(batch);
+  });
+}
+
+size_t loadCsvTrace(const std::string &path, Scheduler &scheduler) {
+  return readCsvTrace(path, [&scheduler](std::span<const Process> batch) {
+    scheduler.addProcesses(batch);
+  });
+}
+
+TraceFormat detectTraceFormat(const std::string &path) {
+  FileHandle file(path);
+  char magic[sizeof(kTraceMagic)] = {};
+  const ssize_t got = ::read(file.get(), magic, sizeof(magic));
+  if (got == static_cast<ssize_t>(sizeof(magic)) &&
+      std::memcmp(magic, kTraceMagic, sizeof(kTraceMagic)) == 0) {
+    return TraceFormat::Binary;
+  }
+  return TraceFormat::Csv;
+}
+
+// TraceWriter
+TraceWriter::TraceWriter(const std::string &path, TraceFormat format)
+    : out(std::fopen(path.c_str(), format == TraceFormat::Binary ? "wb" : "w")),
+      format(format) {
+  if (out == nullptr) {
+    throw std::runtime_error("Cannot create trace file: " + path);
+  }
+
+  if (format == TraceFormat::Binary) {
+    // The record count is patched in by close()
+    TraceHeader header{};
+    std::memcpy(header.magic, kTraceMagic, sizeof(kTraceMagic));
+    header.version = kTraceVersion;
+    header.recordSize = sizeof(TraceRecord);
+    failed = std::fwrite(&header, sizeof(header), 1, out) != 1;
+  } else {
+    failed = std::fputs("pid,startTime,burstTime\n", out) < 0;
+  }
+}
+
+TraceWriter::~TraceWriter() {
+  if (out != nullptr) {
+    std::fclose(out);
+  }
+}
+
+void TraceWriter::write(std::span<const Process> procs) {
+  if (format == TraceFormat::Binary) {
+    TraceRecord batch[kBatchSize / 4];
+    constexpr size_t batchLen = sizeof(batch) / sizeof(batch[0]);
+    for (size_t i = 0; !failed && i < procs.size(); i += batchLen) {
+      const size_t n = std::min(batchLen, procs.size() - i);
+      for (size_t j = 0; j < n; ++j) {
+        const auto &proc = procs[i + j];
+        batch[j] = {proc.pid, proc.startTime, proc.burstTime};
+      }
+      failed = std::fwrite(batch, sizeof(TraceRecord), n, out) != n;
+    }
+  } else {
+    for (size_t i = 0; !failed && i < procs.size(); ++i) {
+      failed = std::fprintf(out, "%u,%u,%u\n", procs[i].pid,
+                            procs[i].startTime, procs[i].burstTime) < 0;
+    }
+  }
+  count += procs.size();
+}
+
+void TraceWriter::close() {
+  if (format == TraceFormat::Binary && !failed) {
+    failed = std::fseek(out, offsetof(TraceHeader, count), SEEK_SET) != 0 ||
+             std::fwrite(&count, sizeof(count), 1, out) != 1;
+  }
+  const bool closeFailed = std::fclose(out) != 0;
+  out = nullptr;
+  if (failed || closeFailed) {
+    throw std::runtime_error("Error writing trace file");
+  }
+}
+
+void writeBinaryTrace(const std::string &path, std::span<const Process> procs) {
+  TraceWriter writer(path, TraceFormat::Binary);
+  writer.write(procs);
+  writer.close();
+}
+
+void writeCsvTrace(const std::string &path, std::span<const Process> procs) {
+  TraceWriter writer(path, TraceFormat::Csv);
+  writer.write(procs);
+  writer.close();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "scheduler.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <span>
+#include <string>
+
+// Binary trace layout (native byte order):
+//   TraceHeader, followed by `count` TraceRecords
+struct TraceHeader {
+  char magic[8]; // "RRTRACE\0"
+  uint32_t version;
+  uint32_t recordSize;
+  uint64_t count;
+};
+
+struct TraceRecord {
+  uint32_t pid;
+  uint32_t startTime;
+  uint32_t burstTime;
+};
+
+// Receives consecutive batches of processes while a trace is being read
+using TraceSink = std::function<void(std::span<const Process>)>;
+
+// Memory-maps a binary trace and hands its records to `sink` in batches.
+// Returns the number of records in the file.
+size_t readBinaryTrace(const std::string &path, const TraceSink &sink);
+
+// Streams a CSV trace with one `pid,startTime,burstTime` line per process.
+// A header line, blank lines and lines starting with '#' are skipped.
+// Returns the number of processes parsed.
+size_t readCsvTrace(const std::string &path, const TraceSink &sink);
+
+// Loaders that feed a trace straight into a scheduler through addProcesses
+size_t loadBinaryTrace(const std::string &path, Scheduler &scheduler);
+size_t loadCsvTrace(const std::string &path, Scheduler &scheduler);
+
+enum class TraceFormat { Binary, Csv };
+
+// Looks at the first bytes of a file to tell binary traces from CSV
+TraceFormat detectTraceFormat(const std::string &path);
+
+// Writes a trace incrementally so converting a large file never needs the
+// whole trace in memory
+class TraceWriter {
+private:
+  std::FILE *out;
+  TraceFormat format;
+  uint64_t count = 0;
+  bool failed = false;
+
+public:
+  TraceWriter(const std::string &path, TraceFormat format);
+  ~TraceWriter();
+  TraceWriter(const TraceWriter &) = delete;
+  TraceWriter &operator=(const TraceWriter &) = delete;
+
+  void write(std::span<const Process> procs);
+  // Finalises the header and flushes; throws if anything failed to write
+  void close();
+};
+
+void writeBinaryTrace(const std::string &path, std::span<const Process> procs);
+void writeCsvTrace(const std::string &path, std::span<const Process> procs);